@@ -43,8 +43,24 @@ TL::StatusCode TL::Algorithm::execute() {
   return TL::StatusCode::SUCCESS;
 }
 
+TL::StatusCode TL::Algorithm::executeBatch(const TL::EventBatch& batch) {
+  m_eventCounter += batch.size();
+  return TL::StatusCode::SUCCESS;
+}
+
 TL::StatusCode TL::Algorithm::finish() { return TL::StatusCode::SUCCESS; }
 
+TL::StatusCode TL::Algorithm::merge(const TL::Algorithm& replica) {
+  m_eventCounter += replica.m_eventCounter;
+  return TL::StatusCode::SUCCESS;
+}
+
+TL::StatusCode TL::Algorithm::checkpointState(TList&) const {
+  return TL::StatusCode::SUCCESS;
+}
+
+TL::StatusCode TL::Algorithm::restoreState(const TList&) { return TL::StatusCode::SUCCESS; }
+
 const TL::FileManager* TL::Algorithm::fileManager() const { return m_fm.get(); }
 
 const std::shared_ptr<TTreeReader>& TL::Algorithm::reader() const { return m_reader; }
@@ -63,15 +79,14 @@ const std::shared_ptr<TTreeReader>& TL::Algorithm::truthReader() const {
 
 std::shared_ptr<TTreeReader>& TL::Algorithm::weightsReader() { return m_weightsReader; }
 
-TL::StatusCode TL::Algorithm::setFileManager(std::unique_ptr<TL::FileManager> fm) {
+TL::StatusCode TL::Algorithm::setFileManager(std::shared_ptr<TL::FileManager> fm) {
   if (fm == nullptr) {
     logger()->error("TL::EDM::FileManager is nullptr");
     return TL::StatusCode::FAILURE;
   }
   m_fm = std::move(fm);
   m_totalEntries = m_fm->mainChain()->GetEntries();
-  m_isNominalTree = m_fm->treeName() == "nominal";
-  m_isNominalTree_Loose = m_fm->treeName() == "nominal_Loose";
+  setCurrentTree(m_fm->treeName());
   auto camp = m_fm->getCampaign();
   if (camp == TL::kCampaign::Unknown) {
     logger()->warn("Unknown campaign, TL::Algorithm is going to assume this is data");
@@ -87,6 +102,27 @@ TL::StatusCode TL::Algorithm::setFileManager(std::unique_ptr<TL::FileManager> fm
   return TL::StatusCode::SUCCESS;
 }
 
+TL::StatusCode TL::Algorithm::shareInput(const TL::Algorithm& primary) {
+  if (primary.m_reader == nullptr) {
+    logger()->error("Cannot share the input of an algorithm which is not initialized");
+    return TL::StatusCode::FAILURE;
+  }
+  TL_CHECK(setFileManager(primary.m_fm));
+  m_reader = primary.m_reader;
+  m_weightsReader = primary.m_weightsReader;
+  m_particleLevelReader = primary.m_particleLevelReader;
+  m_truthReader = primary.m_truthReader;
+  m_lazyParticleLevel = primary.m_lazyParticleLevel;
+  m_lazyTruth = primary.m_lazyTruth;
+  return TL::StatusCode::SUCCESS;
+}
+
+void TL::Algorithm::setCurrentTree(const std::string& treeName) {
+  m_currentTreeName = treeName;
+  m_isNominalTree = treeName == "nominal";
+  m_isNominalTree_Loose = treeName == "nominal_Loose";
+}
+
 void TL::Algorithm::checkRelease() {
   /*** Figuring out if we're using release 20.7 sample ***/
   auto rucioDirStr = fileManager()->rucioDir();
@@ -0,0 +1,162 @@
+/*! @file Checkpointer.cxx
+ *  @brief TL::Checkpointer class implementation
+ */
+
+// TL
+#include <TopLoop/Core/Checkpointer.h>
+
+// ROOT
+#include <TFile.h>
+#include <TParameter.h>
+
+// Boost
+#include <boost/filesystem/operations.hpp>
+namespace fs = boost::filesystem;
+
+// C++
+#include <cmath>
+#include <cstdio>
+
+namespace {
+
+/// the largest share of the interval a snapshot may take on the event loop thread
+constexpr double maxSnapshotShare = 0.05;
+
+}  // namespace
+
+TL::Checkpointer::Checkpointer(const std::string& path, std::chrono::seconds interval)
+    : TL::Loggable("TL::Checkpointer"),
+      m_path(path),
+      m_interval(interval),
+      m_lastSave(std::chrono::steady_clock::now()) {}
+
+TL::Checkpointer::~Checkpointer() {
+  if (m_pendingWrite.valid()) {
+    m_pendingWrite.wait();
+  }
+}
+
+bool TL::Checkpointer::exists() const { return fs::exists(m_path); }
+
+bool TL::Checkpointer::due() const {
+  if (std::chrono::steady_clock::now() - m_lastSave < m_interval) {
+    return false;
+  }
+  // a snapshot taken now would be skipped by save()
+  return not m_pendingWrite.valid() ||
+         m_pendingWrite.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+}
+
+void TL::Checkpointer::addSnapshotTime(std::chrono::duration<double> t) {
+  m_snapshotTime += t;
+  if (t.count() > maxSnapshotShare * m_interval.count()) {
+    m_interval = std::chrono::seconds(
+        static_cast<std::chrono::seconds::rep>(std::ceil(t.count() / maxSnapshotShare)));
+    logger()->warn("A checkpoint took {:.2f} s, checkpointing every {} s from now on",
+                   t.count(), m_interval.count());
+  }
+}
+
+bool TL::Checkpointer::writeFile(const TL::CheckpointProgress& progress,
+                                 const std::vector<std::unique_ptr<TList>>& states) const {
+  const std::string tmpPath = m_path + ".tmp";
+  {
+    std::unique_ptr<TFile> file(TFile::Open(tmpPath.c_str(), "RECREATE"));
+    if (file == nullptr || file->IsZombie()) {
+      return false;
+    }
+    TList info;
+    info.SetOwner(true);
+    info.Add(new TParameter<Long64_t>("firstEntry", progress.firstEntry));
+    info.Add(new TParameter<Long64_t>("lastEntry", progress.lastEntry));
+    info.Add(new TParameter<Long64_t>("nextEntry", progress.nextEntry));
+    file->WriteTObject(&info, "TL_checkpoint", "SingleKey");
+    for (std::size_t i = 0; i < states.size(); ++i) {
+      file->WriteTObject(states[i].get(), fmt::format("TL_state_{}", i).c_str(),
+                         "SingleKey");
+    }
+    file->Close();
+  }
+  // the previous checkpoint is only replaced by a complete file
+  return std::rename(tmpPath.c_str(), m_path.c_str()) == 0;
+}
+
+void TL::Checkpointer::save(const TL::CheckpointProgress& progress,
+                            std::vector<std::unique_ptr<TList>> states) {
+  m_lastSave = std::chrono::steady_clock::now();
+  if (m_pendingWrite.valid()) {
+    if (m_pendingWrite.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+      logger()->warn("Previous checkpoint still being written, skipping this one");
+      m_nSkipped++;
+      return;
+    }
+    if (not m_pendingWrite.get()) {
+      logger()->warn("Writing the checkpoint {} failed", m_path);
+    }
+  }
+  m_pendingWrite =
+      std::async(std::launch::async, [this, progress, states = std::move(states)] {
+        return writeFile(progress, states);
+      });
+  m_nSaved++;
+  logger()->debug("Checkpoint at entry {} started", progress.nextEntry);
+}
+
+TL::StatusCode TL::Checkpointer::load(TL::CheckpointProgress& progress,
+                                      std::vector<std::unique_ptr<TList>>& states) const {
+  std::unique_ptr<TFile> file(TFile::Open(m_path.c_str(), "READ"));
+  if (file == nullptr || file->IsZombie()) {
+    logger()->error("Cannot open the checkpoint file {}", m_path);
+    return TL::StatusCode::FAILURE;
+  }
+  std::unique_ptr<TList> info(dynamic_cast<TList*>(file->Get("TL_checkpoint")));
+  if (info == nullptr) {
+    logger()->error("{} is not a TopLoop checkpoint file", m_path);
+    return TL::StatusCode::FAILURE;
+  }
+  info->SetOwner(true);
+  auto entryOf = [&info](const char* name, uint64_t& value) {
+    auto par = dynamic_cast<TParameter<Long64_t>*>(info->FindObject(name));
+    if (par == nullptr) {
+      return false;
+    }
+    value = par->GetVal();
+    return true;
+  };
+  if (not(entryOf("firstEntry", progress.firstEntry) &&
+          entryOf("lastEntry", progress.lastEntry) &&
+          entryOf("nextEntry", progress.nextEntry))) {
+    logger()->error("The checkpoint file {} is incomplete", m_path);
+    return TL::StatusCode::FAILURE;
+  }
+
+  states.clear();
+  for (std::size_t i = 0;; ++i) {
+    std::unique_ptr<TList> state(
+        dynamic_cast<TList*>(file->Get(fmt::format("TL_state_{}", i).c_str())));
+    if (state == nullptr) {
+      break;
+    }
+    state->SetOwner(true);
+    states.push_back(std::move(state));
+  }
+  return TL::StatusCode::SUCCESS;
+}
+
+void TL::Checkpointer::wait() {
+  if (m_pendingWrite.valid() && not m_pendingWrite.get()) {
+    logger()->warn("Writing the checkpoint {} failed", m_path);
+  }
+}
+
+void TL::Checkpointer::remove() const {
+  if (exists()) {
+    fs::remove(m_path);
+  }
+}
+
+void TL::Checkpointer::report() const {
+  logger()->info(
+      "{} checkpoints written to {} ({} skipped), {:.2f} s spent in the event loop",
+      m_nSaved, m_path, m_nSkipped, m_snapshotTime.count());
+}
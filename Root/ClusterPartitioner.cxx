@@ -0,0 +1,184 @@
+/*! @file ClusterPartitioner.cxx
+ *  @brief TL::ClusterPartitioner class implementation
+ */
+
+// TL
+#include <TopLoop/Core/ClusterPartitioner.h>
+
+// ROOT
+#include <TBranch.h>
+#include <TChain.h>
+
+// C++
+#include <algorithm>
+
+TL::ClusterPartitioner::ClusterPartitioner() : TL::Loggable("TL::ClusterPartitioner") {}
+
+TL::StatusCode TL::ClusterPartitioner::scan(TChain* chain) {
+  m_clusters.clear();
+  if (chain == nullptr) {
+    logger()->error("Cannot scan the clusters of a null chain");
+    return TL::StatusCode::FAILURE;
+  }
+
+  // GetEntries() makes sure the tree offsets are known
+  const Long64_t chainEntries = chain->GetEntries();
+  for (Int_t itree = 0; itree < chain->GetNtrees(); ++itree) {
+    const Long64_t offset = chain->GetTreeOffset()[itree];
+    if (offset >= chainEntries) {
+      continue;
+    }
+    if (chain->LoadTree(offset) < 0) {
+      logger()->error("Cannot load tree {} of chain {}", itree, chain->GetName());
+      return TL::StatusCode::FAILURE;
+    }
+    TTree* tree = chain->GetTree();
+    const Long64_t treeEntries = tree->GetEntries();
+
+    const auto firstCluster = m_clusters.size();
+    auto clusterIter = tree->GetClusterIterator(0);
+    Long64_t clusterStart;
+    while ((clusterStart = clusterIter()) < treeEntries) {
+      Long64_t clusterEnd = std::min(clusterIter.GetNextEntry(), treeEntries);
+      m_clusters.push_back({static_cast<uint64_t>(offset + clusterStart),
+                            static_cast<uint64_t>(offset + clusterEnd), 0});
+    }
+    const auto clustersBegin = std::begin(m_clusters) + firstCluster;
+
+    // give the baskets of the active branches to the cluster in which
+    // they start (SgTop ntuples are flat, top level branches are enough)
+    for (const auto obj : *(tree->GetListOfBranches())) {
+      auto branch = static_cast<TBranch*>(obj);
+      if (branch->TestBit(TBranch::kDoNotProcess)) {
+        continue;
+      }
+      const Int_t* basketBytes = branch->GetBasketBytes();
+      const Long64_t* basketEntry = branch->GetBasketEntry();
+      for (Int_t ibasket = 0; ibasket < branch->GetWriteBasket(); ++ibasket) {
+        const uint64_t entry = offset + basketEntry[ibasket];
+        auto cluster = std::upper_bound(
+            clustersBegin, std::end(m_clusters), entry,
+            [](uint64_t e, const Cluster& c) { return e < c.first; });
+        if (cluster != clustersBegin) {
+          std::prev(cluster)->zipBytes += basketBytes[ibasket];
+        }
+      }
+    }
+  }
+
+  logger()->info("Found {} clusters in {} trees of chain {}", m_clusters.size(),
+                 chain->GetNtrees(), chain->GetName());
+  return TL::StatusCode::SUCCESS;
+}
+
+std::vector<TL::WorkUnit> TL::ClusterPartitioner::partition(std::size_t n, uint64_t first,
+                                                            uint64_t last) const {
+  std::vector<TL::WorkUnit> units;
+  if (n == 0 || first >= last) {
+    return units;
+  }
+
+  // the clusters clipped to the range, clusters cut by the range
+  // edges get a share of the bytes proportional to their entries
+  std::vector<Cluster> clipped;
+  for (const auto& cluster : m_clusters) {
+    if (cluster.last <= first || cluster.first >= last) {
+      continue;
+    }
+    Cluster c{std::max(cluster.first, first), std::min(cluster.last, last), 0};
+    c.zipBytes = cluster.zipBytes * (c.last - c.first) / (cluster.last - cluster.first);
+    clipped.push_back(c);
+  }
+  if (clipped.empty()) {
+    // no cluster information (scan not called); a single unit
+    units.push_back({first, last, 0, 0});
+    return units;
+  }
+
+  uint64_t totalBytes = 0;
+  for (const auto& c : clipped) {
+    totalBytes += c.zipBytes;
+  }
+  const bool useBytes = totalBytes > 0;
+  const uint64_t total = useBytes ? totalBytes : last - first;
+
+  // walk the clusters and close a unit each time the cumulative
+  // weight reaches the next 1/n boundary
+  TL::WorkUnit current;
+  uint64_t cumulative = 0;
+  for (const auto& c : clipped) {
+    if (current.nClusters == 0) {
+      current.first = c.first;
+    }
+    current.last = c.last;
+    current.zipBytes += c.zipBytes;
+    current.nClusters++;
+    cumulative += useBytes ? c.zipBytes : c.last - c.first;
+    if (units.size() + 1 < n && cumulative * n >= total * (units.size() + 1)) {
+      units.push_back(current);
+      current = TL::WorkUnit{};
+    }
+  }
+  if (current.nClusters > 0) {
+    units.push_back(current);
+  }
+  return units;
+}
+
+bool TL::ClusterPartitioner::isClusterBoundary(uint64_t entry) const {
+  if (m_clusters.empty() || entry == m_clusters.back().last) {
+    return true;
+  }
+  auto cluster = std::lower_bound(
+      std::begin(m_clusters), std::end(m_clusters), entry,
+      [](const Cluster& c, uint64_t e) { return c.first < e; });
+  return cluster != std::end(m_clusters) && cluster->first == entry;
+}
+
+std::size_t TL::ClusterPartitioner::clusterIndex(uint64_t entry) const {
+  auto cluster = std::upper_bound(
+      std::begin(m_clusters), std::end(m_clusters), entry,
+      [](uint64_t e, const Cluster& c) { return e < c.first; });
+  if (cluster == std::begin(m_clusters) || entry >= std::prev(cluster)->last) {
+    return m_clusters.size();
+  }
+  return std::distance(std::begin(m_clusters), cluster) - 1;
+}
+
+void TL::ClusterPartitioner::report(const std::vector<TL::WorkUnit>& units) const {
+  if (units.empty()) {
+    logger()->info("No work units");
+    return;
+  }
+  uint64_t minBytes = units.front().zipBytes;
+  uint64_t maxBytes = units.front().zipBytes;
+  for (std::size_t i = 0; i < units.size(); ++i) {
+    const auto& unit = units[i];
+    logger()->info(" -- unit {:4}: entries [{}, {}) ({} entries, {} clusters, {:.1f} MB)",
+                   i, unit.first, unit.last, unit.entries(), unit.nClusters,
+                   unit.zipBytes / 1.0e6);
+    minBytes = std::min(minBytes, unit.zipBytes);
+    maxBytes = std::max(maxBytes, unit.zipBytes);
+  }
+
+  // units are contiguous, so a cluster can only be shared if the
+  // boundary between two units is not a cluster boundary
+  std::size_t nShared = 0;
+  for (std::size_t i = 1; i < units.size(); ++i) {
+    if (not isClusterBoundary(units[i].first)) {
+      nShared++;
+    }
+  }
+  logger()->info("{} units; largest/smallest compressed size: {:.2f}", units.size(),
+                 minBytes > 0 ? static_cast<double>(maxBytes) / minBytes : 0.0);
+  if (nShared > 0) {
+    logger()->warn("{} clusters are shared between units (baskets read twice)", nShared);
+  }
+  else {
+    logger()->info("No cluster is shared between units");
+  }
+  if (not isClusterBoundary(units.front().first) ||
+      not isClusterBoundary(units.back().last)) {
+    logger()->info("The entry range does not start/end on a cluster boundary");
+  }
+}
@@ -0,0 +1,256 @@
+/*! @file ClusterReadAhead.cxx
+ *  @brief TL::ClusterReadAhead class implementation
+ */
+
+// TL
+#include <TopLoop/Core/ClusterReadAhead.h>
+#include <TopLoop/Core/FilePrefetcher.h>
+
+// ROOT
+#include <TBranch.h>
+#include <TChain.h>
+#include <TFile.h>
+#include <TROOT.h>
+
+// Boost
+#include <boost/algorithm/string/predicate.hpp>
+
+// C++
+#include <algorithm>
+
+// POSIX
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace {
+
+/// largest read issued at once, contiguous baskets are merged up to this size
+constexpr Long64_t maxRangeBytes = 16000000;
+
+}  // namespace
+
+TL::ClusterReadAhead::ClusterReadAhead(std::size_t depth)
+    : TL::Loggable("TL::ClusterReadAhead"), m_depth(depth) {
+  // remote files are opened on the I/O thread
+  ROOT::EnableThreadSafety();
+  m_worker = std::thread([this] { work(); });
+}
+
+TL::ClusterReadAhead::~ClusterReadAhead() {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stop = true;
+  }
+  m_wakeUp.notify_one();
+  m_worker.join();
+}
+
+TL::ClusterReadAhead::Clusters TL::ClusterReadAhead::clustersOf(TTree* tree) {
+  Clusters clusters;
+  const Long64_t treeEntries = tree->GetEntries();
+  auto clusterIter = tree->GetClusterIterator(0);
+  Long64_t clusterStart;
+  while ((clusterStart = clusterIter()) < treeEntries) {
+    const Long64_t clusterEnd = std::min(clusterIter.GetNextEntry(), treeEntries);
+    clusters.push_back({clusterStart, clusterEnd - 1, {}});
+  }
+
+  // give the baskets of the active branches to the cluster in which
+  // they start (as TL::ClusterPartitioner does)
+  for (const auto obj : *(tree->GetListOfBranches())) {
+    auto branch = static_cast<TBranch*>(obj);
+    if (branch->TestBit(TBranch::kDoNotProcess)) {
+      continue;
+    }
+    const Int_t* basketBytes = branch->GetBasketBytes();
+    const Long64_t* basketEntry = branch->GetBasketEntry();
+    for (Int_t ibasket = 0; ibasket < branch->GetWriteBasket(); ++ibasket) {
+      auto cluster = std::upper_bound(
+          std::begin(clusters), std::end(clusters), basketEntry[ibasket],
+          [](Long64_t e, const Cluster& c) { return e < c.first; });
+      if (cluster != std::begin(clusters)) {
+        std::prev(cluster)->ranges.emplace_back(branch->GetBasketSeek(ibasket),
+                                                basketBytes[ibasket]);
+      }
+    }
+  }
+
+  // the baskets of a cluster are mostly written next to each other
+  for (auto& cluster : clusters) {
+    auto& ranges = cluster.ranges;
+    std::sort(std::begin(ranges), std::end(ranges));
+    std::vector<std::pair<Long64_t, Long64_t>> merged;
+    for (const auto& range : ranges) {
+      if (not merged.empty() && merged.back().first + merged.back().second == range.first &&
+          merged.back().second + range.second <= maxRangeBytes) {
+        merged.back().second += range.second;
+      }
+      else {
+        merged.push_back(range);
+      }
+    }
+    ranges = std::move(merged);
+  }
+  return clusters;
+}
+
+void TL::ClusterReadAhead::update(const TChain* chain) {
+  TTree* tree = chain->GetTree();
+  if (tree == nullptr) {
+    return;
+  }
+  const bool newTree = chain->GetTreeNumber() != m_treeNumber;
+  if (newTree) {
+    m_treeNumber = chain->GetTreeNumber();
+    m_loopClusters = std::make_shared<const Clusters>(clustersOf(tree));
+    m_current = 0;
+  }
+  const auto& clusters = *m_loopClusters;
+  const Long64_t entry = tree->GetReadEntry();
+  if (clusters.empty() ||
+      (not newTree && entry >= clusters[m_current].first &&
+       entry <= clusters[m_current].last)) {
+    return;
+  }
+
+  // the loop entered another cluster, move the window
+  auto cluster = std::upper_bound(std::begin(clusters), std::end(clusters), entry,
+                                  [](Long64_t e, const Cluster& c) { return e < c.first; });
+  m_current = cluster == std::begin(clusters)
+                  ? 0
+                  : std::distance(std::begin(clusters), cluster) - 1;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (newTree) {
+      const TFile* file = chain->GetCurrentFile();
+      m_clusters = file != nullptr ? m_loopClusters : nullptr;
+      m_fileName = file != nullptr ? file->GetName() : "";
+      m_generation++;
+      m_readFrom = m_current + 1;
+    }
+    // jumping back invalidates the clusters read ahead
+    if (m_readFrom <= m_current || m_current < m_loopCluster) {
+      m_readFrom = m_current + 1;
+    }
+    m_loopCluster = m_current;
+  }
+  m_wakeUp.notify_one();
+}
+
+void TL::ClusterReadAhead::work() {
+  std::vector<char> buffer;
+  std::size_t openGeneration = 0;
+  int fd = -1;
+  std::unique_ptr<TFile> file{nullptr};
+  auto closeFile = [&fd, &file] {
+    if (fd >= 0) {
+      ::close(fd);
+      fd = -1;
+    }
+    file.reset();
+  };
+
+  while (true) {
+    std::shared_ptr<const Clusters> clusters;
+    std::string fileName;
+    std::size_t generation = 0;
+    std::size_t index = 0;
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      // back-pressure: wait until the window has room
+      m_wakeUp.wait(lock, [this] {
+        return m_stop || (m_clusters != nullptr && m_readFrom < m_clusters->size() &&
+                          m_readFrom <= m_loopCluster + m_depth);
+      });
+      if (m_stop) {
+        break;
+      }
+      clusters = m_clusters;
+      fileName = m_fileName;
+      generation = m_generation;
+      index = m_readFrom;
+    }
+
+    if (generation != openGeneration) {
+      closeFile();
+      openGeneration = generation;
+      if (TL::FilePrefetcher::isLocal(fileName)) {
+        const std::string path = boost::algorithm::starts_with(fileName, "file:")
+                                     ? fileName.substr(5)
+                                     : fileName;
+        fd = ::open(path.c_str(), O_RDONLY);
+      }
+      else {
+        file.reset(TFile::Open(fileName.c_str(), "READ"));
+        if (file != nullptr && file->IsZombie()) {
+          file.reset();
+        }
+      }
+      if (fd < 0 && file == nullptr) {
+        logger()->debug("Cannot open {} for reading ahead", fileName);
+      }
+    }
+
+    const Cluster& cluster = (*clusters)[index];
+    bool ok = false;
+    if (fd >= 0) {
+      ok = readLocal(fd, cluster, buffer);
+    }
+    else if (file != nullptr) {
+      ok = readRemote(*file, cluster, buffer);
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    // the loop may have moved to another file or jumped meanwhile
+    if (generation == m_generation && index == m_readFrom) {
+      m_readFrom++;
+    }
+    if (ok) {
+      m_nRead++;
+      for (const auto& range : cluster.ranges) {
+        m_nBytes += range.second;
+      }
+    }
+    else {
+      m_nFailed++;
+    }
+  }
+  closeFile();
+}
+
+bool TL::ClusterReadAhead::readLocal(int fd, const Cluster& cluster,
+                                     std::vector<char>& buffer) {
+  for (const auto& range : cluster.ranges) {
+    buffer.resize(std::max<std::size_t>(buffer.size(), range.second));
+    if (::pread(fd, buffer.data(), range.second, range.first) != range.second) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool TL::ClusterReadAhead::readRemote(TFile& file, const Cluster& cluster,
+                                      std::vector<char>& buffer) {
+  // one vector read per cluster, the buffer is reused
+  std::vector<Long64_t> positions;
+  std::vector<Int_t> lengths;
+  std::size_t totalBytes = 0;
+  for (const auto& range : cluster.ranges) {
+    positions.push_back(range.first);
+    lengths.push_back(static_cast<Int_t>(range.second));
+    totalBytes += range.second;
+  }
+  if (positions.empty()) {
+    return true;
+  }
+  buffer.resize(std::max(buffer.size(), totalBytes));
+  // ReadBuffers returns kTRUE on failure
+  return not file.ReadBuffers(buffer.data(), positions.data(), lengths.data(),
+                              static_cast<Int_t>(positions.size()));
+}
+
+void TL::ClusterReadAhead::report() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  logger()->info("Read {} clusters ahead ({:.1f} MB), {} reads failed", m_nRead,
+                 m_nBytes / 1.0e6, m_nFailed);
+}
@@ -0,0 +1,53 @@
+/*! @file EventBatch.cxx
+ *  @brief TL::EventBatch class implementation
+ */
+
+// TL
+#include <TopLoop/Core/EventBatch.h>
+
+TL::EventBatch::EventBatch() : TL::Loggable("TL::EventBatch") {}
+
+bool TL::EventBatch::hasBranch(const std::shared_ptr<TTreeReader>& reader,
+                               const std::string& name) const {
+  if (reader == nullptr || reader->GetTree() == nullptr) {
+    logger()->error("Cannot add column {}, the reader has no tree", name);
+    return false;
+  }
+  if (reader->GetTree()->GetBranch(name.c_str()) == nullptr) {
+    logger()->error("Cannot add column {}, branch not found in tree {}", name,
+                    reader->GetTree()->GetName());
+    return false;
+  }
+  return true;
+}
+
+const TL::EventBatch::ColumnBase* TL::EventBatch::findColumn(const std::string& name) const {
+  auto itr = m_columns.find(name);
+  if (itr == std::end(m_columns)) {
+    return nullptr;
+  }
+  return itr->second.get();
+}
+
+void TL::EventBatch::reserve(std::size_t n) {
+  for (auto& col : m_columns) {
+    col.second->reserve(n);
+  }
+}
+
+void TL::EventBatch::fill(uint64_t entry) {
+  if (m_size == 0) {
+    m_firstEntry = entry;
+  }
+  for (auto& col : m_columns) {
+    col.second->fill();
+  }
+  m_size++;
+}
+
+void TL::EventBatch::clear() {
+  for (auto& col : m_columns) {
+    col.second->clear();
+  }
+  m_size = 0;
+}
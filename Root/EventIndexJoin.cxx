@@ -0,0 +1,343 @@
+/*! @file EventIndexJoin.cxx
+ *  @brief TL::EventIndexJoin class implementation
+ */
+
+// TL
+#include <TopLoop/Core/EventIndexJoin.h>
+
+// ROOT
+#include <TChain.h>
+#include <TChainElement.h>
+#include <TFile.h>
+#include <TROOT.h>
+
+// Boost
+#include <boost/filesystem/path.hpp>
+
+// C++
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <limits>
+#include <memory>
+#include <thread>
+
+TL::EventIndexJoin::EventIndexJoin() : TL::Loggable("TL::EventIndexJoin") {}
+
+uint64_t TL::EventIndexJoin::packKey(UInt_t runNumber, ULong64_t eventNumber) {
+  // run numbers fit in 24 bits and event numbers in 40 bits for
+  // all samples we know of; anything larger only causes collisions,
+  // which the join resolves on the exact values
+  constexpr uint64_t eventMask = (uint64_t{1} << 40) - 1;
+  return (static_cast<uint64_t>(runNumber) << 40) ^ (eventNumber & eventMask) ^
+         (eventNumber >> 40);
+}
+
+std::vector<TL::EventIndexJoin::Record> TL::EventIndexJoin::sortedRecords(
+    const TL::EventKeys& keys) {
+  std::vector<Record> records(keys.size());
+  for (std::size_t i = 0; i < keys.size(); ++i) {
+    records[i] = {packKey(keys.runNumber[i], keys.eventNumber[i]), i};
+  }
+
+  // LSD radix sort, 8 passes of 8 bits; it is stable so records with
+  // the same key stay in entry order. Passes where all of the
+  // records have the same digit (e.g. the high bits of the run
+  // number) are skipped.
+  std::vector<Record> buffer(records.size());
+  for (int shift = 0; shift < 64; shift += 8) {
+    std::array<std::size_t, 257> offsets{};
+    for (const auto& r : records) {
+      offsets[((r.key >> shift) & 0xff) + 1]++;
+    }
+    if (std::any_of(std::begin(offsets), std::end(offsets),
+                    [&records](std::size_t n) { return n == records.size(); })) {
+      continue;
+    }
+    for (std::size_t i = 1; i < offsets.size(); ++i) {
+      offsets[i] += offsets[i - 1];
+    }
+    for (const auto& r : records) {
+      buffer[offsets[(r.key >> shift) & 0xff]++] = r;
+    }
+    records.swap(buffer);
+  }
+  return records;
+}
+
+TL::StatusCode TL::EventIndexJoin::readKeys(const TChain* chain,
+                                            TL::EventKeys& keys) const {
+  if (chain == nullptr) {
+    logger()->error("Cannot read the event keys of a null chain");
+    return TL::StatusCode::FAILURE;
+  }
+  // make a copy for this isolated task
+  auto copy = std::unique_ptr<TChain>(dynamic_cast<TChain*>(chain->Clone()));
+  return readTreeKeys(copy.get(), keys);
+}
+
+TL::StatusCode TL::EventIndexJoin::readTreeKeys(TTree* tree, TL::EventKeys& keys) const {
+  tree->SetBranchStatus("*", 0);
+  tree->SetBranchStatus("runNumber", 1);
+  tree->SetBranchStatus("eventNumber", 1);
+  tree->SetCacheSize(25000000);  // 25 MB cache
+  tree->AddBranchToCache("*", false);
+  tree->AddBranchToCache("runNumber", true);
+  tree->AddBranchToCache("eventNumber", true);
+
+  UInt_t runNumber;
+  ULong64_t eventNumber;
+  tree->SetBranchAddress("runNumber", &runNumber);
+  tree->SetBranchAddress("eventNumber", &eventNumber);
+
+  const Long64_t nEntries = tree->GetEntries();
+  keys.runNumber.resize(nEntries);
+  keys.eventNumber.resize(nEntries);
+  for (Long64_t i = 0; i < nEntries; ++i) {
+    if (tree->GetEntry(i) <= 0) {
+      logger()->error("Cannot read entry {} of tree {}", i, tree->GetName());
+      return TL::StatusCode::FAILURE;
+    }
+    keys.runNumber[i] = runNumber;
+    keys.eventNumber[i] = eventNumber;
+  }
+  tree->ResetBranchAddresses();
+  return TL::StatusCode::SUCCESS;
+}
+
+void TL::EventIndexJoin::join(const TL::EventKeys& particleLevel,
+                              const TL::EventKeys& recoLevel,
+                              std::vector<std::pair<uint64_t, uint64_t>>* particleAndReco,
+                              std::vector<uint64_t>* particleLevelOnly,
+                              std::vector<uint64_t>* recoLevelOnly) const {
+  auto start = std::chrono::steady_clock::now();
+  const auto nMatched =
+      matchKeys(particleLevel, recoLevel, particleAndReco, particleLevelOnly, recoLevelOnly);
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  logger()->info("Joined {} particle level and {} reco entries: {} matched ({:.2f} s)",
+                 particleLevel.size(), recoLevel.size(), nMatched, elapsed.count());
+}
+
+std::size_t TL::EventIndexJoin::matchKeys(
+    const TL::EventKeys& particleLevel, const TL::EventKeys& recoLevel,
+    std::vector<std::pair<uint64_t, uint64_t>>* particleAndReco,
+    std::vector<uint64_t>* particleLevelOnly, std::vector<uint64_t>* recoLevelOnly) const {
+  const auto recordsPL = sortedRecords(particleLevel);
+  const auto recordsRL = sortedRecords(recoLevel);
+
+  // the reco entry matched to each particle level entry
+  constexpr uint64_t noMatch = std::numeric_limits<uint64_t>::max();
+  std::vector<uint64_t> matchPL(particleLevel.size(), noMatch);
+  std::vector<bool> matchedRL(recoLevel.size(), false);
+
+  auto sameEvent = [&particleLevel, &recoLevel](uint64_t iPL, uint64_t iRL) {
+    return particleLevel.runNumber[iPL] == recoLevel.runNumber[iRL] &&
+           particleLevel.eventNumber[iPL] == recoLevel.eventNumber[iRL];
+  };
+
+  // merge join; for each key, compare the group of particle level
+  // records with the group of reco records (groups have a single
+  // record unless keys collide or events are duplicated)
+  std::size_t iPL = 0;
+  std::size_t iRL = 0;
+  while (iPL < recordsPL.size() && iRL < recordsRL.size()) {
+    const uint64_t key = recordsPL[iPL].key;
+    if (key < recordsRL[iRL].key) {
+      ++iPL;
+      continue;
+    }
+    if (recordsRL[iRL].key < key) {
+      ++iRL;
+      continue;
+    }
+    std::size_t endPL = iPL;
+    while (endPL < recordsPL.size() && recordsPL[endPL].key == key) {
+      ++endPL;
+    }
+    std::size_t endRL = iRL;
+    while (endRL < recordsRL.size() && recordsRL[endRL].key == key) {
+      ++endRL;
+    }
+    for (std::size_t p = iPL; p < endPL; ++p) {
+      for (std::size_t r = iRL; r < endRL; ++r) {
+        if (sameEvent(recordsPL[p].entry, recordsRL[r].entry)) {
+          // records are in entry order within a group, keep the first reco entry
+          if (matchPL[recordsPL[p].entry] == noMatch) {
+            matchPL[recordsPL[p].entry] = recordsRL[r].entry;
+          }
+          matchedRL[recordsRL[r].entry] = true;
+        }
+      }
+    }
+    iPL = endPL;
+    iRL = endRL;
+  }
+
+  std::size_t nMatched = 0;
+  for (uint64_t i = 0; i < matchPL.size(); ++i) {
+    if (matchPL[i] != noMatch) {
+      nMatched++;
+      if (particleAndReco != nullptr) {
+        particleAndReco->emplace_back(i, matchPL[i]);
+      }
+    }
+    else if (particleLevelOnly != nullptr) {
+      particleLevelOnly->push_back(i);
+    }
+  }
+  if (recoLevelOnly != nullptr) {
+    for (uint64_t i = 0; i < matchedRL.size(); ++i) {
+      if (not matchedRL[i]) {
+        recoLevelOnly->push_back(i);
+      }
+    }
+  }
+  return nMatched;
+}
+
+bool TL::EventIndexJoin::canJoinPerFile(const TChain* particleLevel,
+                                        const TChain* recoLevel) {
+  if (particleLevel == nullptr || recoLevel == nullptr) {
+    return false;
+  }
+  const auto filesPL = particleLevel->GetListOfFiles();
+  const auto filesRL = recoLevel->GetListOfFiles();
+  if (filesPL->GetEntries() != filesRL->GetEntries()) {
+    return false;
+  }
+  // the n-th files must be the same file (or copies of it)
+  for (int i = 0; i < filesRL->GetEntries(); ++i) {
+    const boost::filesystem::path pathPL(filesPL->At(i)->GetTitle());
+    const boost::filesystem::path pathRL(filesRL->At(i)->GetTitle());
+    if (pathPL != pathRL && pathPL.filename() != pathRL.filename()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+TL::StatusCode TL::EventIndexJoin::joinPerFile(
+    const TChain* particleLevel, const TChain* recoLevel, std::size_t nThreads,
+    std::vector<std::pair<uint64_t, uint64_t>>* particleAndReco,
+    std::vector<uint64_t>* particleLevelOnly, std::vector<uint64_t>* recoLevelOnly) const {
+  if (not canJoinPerFile(particleLevel, recoLevel)) {
+    logger()->error("The chains {} and {} cannot be joined file by file",
+                    particleLevel ? particleLevel->GetName() : "null",
+                    recoLevel ? recoLevel->GetName() : "null");
+    return TL::StatusCode::FAILURE;
+  }
+  auto start = std::chrono::steady_clock::now();
+
+  // the per file results, in local entries
+  struct FileJoin {
+    const TChainElement* particleLevel;
+    const TChainElement* recoLevel;
+    std::vector<std::pair<uint64_t, uint64_t>> particleAndReco{};
+    std::vector<uint64_t> particleLevelOnly{};
+    std::vector<uint64_t> recoLevelOnly{};
+    std::size_t nParticleLevel{0};
+    std::size_t nReco{0};
+    std::size_t nMatched{0};
+  };
+  std::vector<FileJoin> files;
+  for (int i = 0; i < recoLevel->GetListOfFiles()->GetEntries(); ++i) {
+    files.push_back({static_cast<const TChainElement*>(particleLevel->GetListOfFiles()->At(i)),
+                     static_cast<const TChainElement*>(recoLevel->GetListOfFiles()->At(i))});
+  }
+
+  // a tree missing in a file is skipped by TChain, it has no entries
+  auto readKeysOf = [this](TFile* file, const TChainElement* element,
+                           TL::EventKeys& keys) {
+    auto tree = dynamic_cast<TTree*>(file->Get(element->GetName()));
+    return tree == nullptr ? TL::StatusCode::SUCCESS : readTreeKeys(tree, keys);
+  };
+  auto joinFile = [&](FileJoin& fj) {
+    std::unique_ptr<TFile> recoFile(TFile::Open(fj.recoLevel->GetTitle(), "READ"));
+    if (recoFile == nullptr || recoFile->IsZombie()) {
+      logger()->error("Cannot open {}", fj.recoLevel->GetTitle());
+      return false;
+    }
+    std::unique_ptr<TFile> particleLevelFile{nullptr};
+    TFile* plFile = recoFile.get();
+    if (std::string(fj.particleLevel->GetTitle()) != fj.recoLevel->GetTitle()) {
+      particleLevelFile.reset(TFile::Open(fj.particleLevel->GetTitle(), "READ"));
+      if (particleLevelFile == nullptr || particleLevelFile->IsZombie()) {
+        logger()->error("Cannot open {}", fj.particleLevel->GetTitle());
+        return false;
+      }
+      plFile = particleLevelFile.get();
+    }
+    TL::EventKeys keysPL;
+    TL::EventKeys keysRL;
+    if (readKeysOf(plFile, fj.particleLevel, keysPL).isFailure() ||
+        readKeysOf(recoFile.get(), fj.recoLevel, keysRL).isFailure()) {
+      return false;
+    }
+    fj.nParticleLevel = keysPL.size();
+    fj.nReco = keysRL.size();
+    fj.nMatched = matchKeys(keysPL, keysRL, particleAndReco ? &fj.particleAndReco : nullptr,
+                            particleLevelOnly ? &fj.particleLevelOnly : nullptr,
+                            recoLevelOnly ? &fj.recoLevelOnly : nullptr);
+    return true;
+  };
+
+  // workers take the next file when they are done with one
+  ROOT::EnableThreadSafety();
+  nThreads = std::max<std::size_t>(std::min(nThreads, files.size()), 1);
+  std::atomic<std::size_t> nextFile{0};
+  std::atomic<bool> failed{false};
+  auto work = [&]() {
+    for (std::size_t i = nextFile++; i < files.size() && not failed; i = nextFile++) {
+      if (not joinFile(files[i])) {
+        failed = true;
+      }
+    }
+  };
+  std::vector<std::thread> threads;
+  for (std::size_t i = 0; i < nThreads; ++i) {
+    threads.emplace_back(work);
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  if (failed) {
+    logger()->error("Joining the chains {} and {} file by file failed",
+                    particleLevel->GetName(), recoLevel->GetName());
+    return TL::StatusCode::FAILURE;
+  }
+
+  // concatenate, in file order, shifted by the global entry offsets
+  uint64_t offsetPL = 0;
+  uint64_t offsetRL = 0;
+  std::size_t nMatched = 0;
+  for (auto& fj : files) {
+    if (particleAndReco != nullptr) {
+      for (const auto& idx : fj.particleAndReco) {
+        particleAndReco->emplace_back(idx.first + offsetPL, idx.second + offsetRL);
+      }
+    }
+    if (particleLevelOnly != nullptr) {
+      for (const auto idx : fj.particleLevelOnly) {
+        particleLevelOnly->push_back(idx + offsetPL);
+      }
+    }
+    if (recoLevelOnly != nullptr) {
+      for (const auto idx : fj.recoLevelOnly) {
+        recoLevelOnly->push_back(idx + offsetRL);
+      }
+    }
+    offsetPL += fj.nParticleLevel;
+    offsetRL += fj.nReco;
+    nMatched += fj.nMatched;
+    // release the per file vectors as we go
+    fj = FileJoin{fj.particleLevel, fj.recoLevel};
+  }
+
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  logger()->info(
+      "Joined {} particle level and {} reco entries of {} files on {} threads: {} matched "
+      "({:.2f} s)",
+      offsetPL, offsetRL, files.size(), nThreads, nMatched, elapsed.count());
+  return TL::StatusCode::SUCCESS;
+}
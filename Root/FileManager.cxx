@@ -15,18 +15,136 @@
 #include <boost/filesystem/path.hpp>
 namespace fs = boost::filesystem;
 
+// ROOT
+#include <TBranch.h>
+#include <TChainElement.h>
+#include <TFile.h>
+#include <TTreeCache.h>
+
 // C++
+#include <algorithm>
 #include <cstdlib>
 #include <fstream>
 #include <random>
 #include <regex>
 #include <string>
 
+namespace {
+
+/// add the files of one chain to another (without reopening them)
+void copyChainFiles(const TChain* from, TChain* to) {
+  for (const auto obj : *(from->GetListOfFiles())) {
+    auto element = static_cast<const TChainElement*>(obj);
+    to->AddFile(element->GetTitle(), element->GetEntries());
+  }
+}
+
+/// the bytes a chain read through its cache and around it
+Long64_t chainBytesRead(const TChain* chain) {
+  if (chain->GetCurrentFile() == nullptr) {
+    return 0;
+  }
+  const TTreeCache* cache = chain->GetReadCache(chain->GetCurrentFile());
+  if (cache == nullptr) {
+    return chain->GetCurrentFile()->GetBytesRead();
+  }
+  return cache->GetBytesRead() + cache->GetNoCacheBytesRead();
+}
+
+/// apply the SetBranchStatus calls made on one chain to another
+void copyBranchStatus(const TChain* from, TTree* to) {
+  if (from->GetStatus() == nullptr) {
+    return;
+  }
+  for (const auto obj : *(from->GetStatus())) {
+    auto element = static_cast<const TChainElement*>(obj);
+    to->SetBranchStatus(element->GetName(), element->GetStatus());
+  }
+}
+
+/// the SetBranchStatus calls made on a chain, in order
+std::vector<std::pair<std::string, bool>> branchStatusOf(const TChain* chain) {
+  std::vector<std::pair<std::string, bool>> status;
+  if (chain == nullptr || chain->GetStatus() == nullptr) {
+    return status;
+  }
+  for (const auto obj : *(chain->GetStatus())) {
+    auto element = static_cast<const TChainElement*>(obj);
+    status.emplace_back(element->GetName(), element->GetStatus() != 0);
+  }
+  return status;
+}
+
+/// add the active branches of a tree (or of the current tree of a chain) to its cache
+std::size_t cacheActiveBranches(TTree* tree) {
+  std::size_t nCached = 0;
+  for (const auto obj : *(tree->GetTree()->GetListOfBranches())) {
+    auto branch = static_cast<TBranch*>(obj);
+    if (not branch->TestBit(TBranch::kDoNotProcess)) {
+      tree->AddBranchToCache(branch->GetName(), true);
+      nCached++;
+    }
+  }
+  tree->StopCacheLearningPhase();
+  return nCached;
+}
+
+}  // namespace
+
 TL::FileManager::FileManager() : TL::Loggable("TL::FileManager") {}
 
 void TL::FileManager::enableParticleLevel() { m_doParticleLevel = true; }
 
-void TL::FileManager::setTreeName(const std::string& tn) { m_treeName = tn; }
+std::unique_ptr<TL::FileManager> TL::FileManager::clone() const {
+  auto fm = std::make_unique<TL::FileManager>();
+  fm->m_doParticleLevel = m_doParticleLevel;
+  fm->m_fileNames = m_fileNames;
+  fm->m_plTreeName = m_plTreeName;
+  fm->m_treeName = m_treeName;
+  fm->m_treeNames = m_treeNames;
+  fm->m_weightsTreeName = m_weightsTreeName;
+  fm->m_truthTreeName = m_truthTreeName;
+  fm->m_rucioDirName = m_rucioDirName;
+  fm->m_dsid = m_dsid;
+  fm->m_isAFII = m_isAFII;
+  fm->m_sgtopNtupVersion = m_sgtopNtupVersion;
+  fm->m_campaign = m_campaign;
+  fm->m_cachePolicies = m_cachePolicies;
+  fm->m_cacheBudget = m_cacheBudget;
+  fm->m_prefetchFiles = m_prefetchFiles;
+  if (m_rootChain == nullptr) {
+    return fm;
+  }
+
+  if (fm->initChain().isFailure()) {
+    logger()->error("Cannot initialize the chains of the cloned FileManager");
+    return nullptr;
+  }
+  copyChainFiles(m_rootChain.get(), fm->m_rootChain.get());
+  copyChainFiles(m_rootWeightsChain.get(), fm->m_rootWeightsChain.get());
+  copyBranchStatus(m_rootChain.get(), fm->m_rootChain.get());
+  if (m_doParticleLevel) {
+    copyChainFiles(m_particleLevelChain.get(), fm->m_particleLevelChain.get());
+    copyChainFiles(m_truthChain.get(), fm->m_truthChain.get());
+    copyBranchStatus(m_particleLevelChain.get(), fm->m_particleLevelChain.get());
+    copyBranchStatus(m_truthChain.get(), fm->m_truthChain.get());
+  }
+  return fm;
+}
+
+void TL::FileManager::setTreeName(const std::string& tn) {
+  m_treeName = tn;
+  m_treeNames = {tn};
+}
+
+void TL::FileManager::setTreeNames(const std::vector<std::string>& tns) {
+  if (tns.empty()) {
+    logger()->error("setTreeNames called with an empty list, keeping {}", m_treeName);
+    return;
+  }
+  m_treeName = tns.front();
+  m_treeNames = tns;
+}
 
 void TL::FileManager::setWeightsTreeName(const std::string& tn) { m_weightsTreeName = tn; }
 
@@ -34,6 +152,247 @@ void TL::FileManager::setParticleLevelTreeName(const std::string& tn) { m_plTree
 
 void TL::FileManager::setTruthTreeName(const std::string& tn) { m_truthTreeName = tn; }
 
+void TL::FileManager::applyBranchStatus(TTree* tree) const {
+  if (m_rootChain == nullptr || tree == nullptr) {
+    return;
+  }
+  copyBranchStatus(m_rootChain.get(), tree);
+}
+
+void TL::FileManager::setCachePolicy(Chain chain, const CachePolicy& policy) {
+  m_cachePolicies[chain] = policy;
+}
+
+TL::FileManager::CachePolicy TL::FileManager::cachePolicy(Chain chain) const {
+  auto itr = m_cachePolicies.find(chain);
+  return itr == std::end(m_cachePolicies) ? CachePolicy{} : itr->second;
+}
+
+TChain* TL::FileManager::chain(Chain chain) const {
+  switch (chain) {
+    case Chain::Main:
+      return mainChain();
+    case Chain::Weights:
+      return weightsChain();
+    case Chain::ParticleLevel:
+      return particleLevelChain();
+    case Chain::Truth:
+      return truthChain();
+  }
+  return nullptr;
+}
+
+TL::StatusCode TL::FileManager::applyCachePolicies() const {
+  // the number of learning entries is shared by all caches
+  Int_t learnEntries = -1;
+  for (const auto& entry : m_cachePolicies) {
+    const Int_t n = entry.second.learnEntries;
+    if (n < 0) {
+      continue;
+    }
+    if (learnEntries >= 0 && n != learnEntries) {
+      logger()->error(
+          "The cache policies set {} and {} learning entries, ROOT only has one value "
+          "for all chains",
+          learnEntries, n);
+      return TL::StatusCode::FAILURE;
+    }
+    learnEntries = n;
+  }
+  if (learnEntries >= 0) {
+    TTreeCache::SetLearnEntries(learnEntries);
+  }
+
+  for (const auto& entry : m_cachePolicies) {
+    TChain* ch = chain(entry.first);
+    const CachePolicy& policy = entry.second;
+    if (ch == nullptr) {
+      continue;
+    }
+    // the cache is attached to the current file, which the chain
+    // carries over when it moves to the next one
+    if (ch->GetTree() == nullptr && ch->LoadTree(0) < 0) {
+      logger()->error("Cannot load the first tree of chain {}", ch->GetName());
+      return TL::StatusCode::FAILURE;
+    }
+    if (policy.size >= 0) {
+      ch->SetCacheSize(policy.size);
+    }
+    TTreeCache* cache = ch->GetReadCache(ch->GetCurrentFile(), policy.size != 0);
+    if (cache == nullptr) {
+      logger()->info("Chain {}: no TTreeCache", ch->GetName());
+      continue;
+    }
+    if (policy.prefill) {
+      cache->SetLearnPrefill(TTreeCache::kAllBranches);
+    }
+    if (policy.cacheActiveBranches) {
+      const std::size_t nCached = cacheActiveBranches(ch);
+      logger()->info("Chain {}: {} active branches added to the cache", ch->GetName(),
+                     nCached);
+    }
+    logger()->info("Chain {}: {:.1f} MB TTreeCache", ch->GetName(),
+                   cache->GetBufferSize() / 1.0e6);
+  }
+  return TL::StatusCode::SUCCESS;
+}
+
+void TL::FileManager::recacheActiveBranches(TTree* tree) const {
+  if (tree == nullptr || tree->GetTree() == nullptr ||
+      not cachePolicy(Chain::Main).cacheActiveBranches) {
+    return;
+  }
+  const std::size_t nCached = cacheActiveBranches(tree);
+  logger()->debug("{} active branches added to the cache again", nCached);
+}
+
+void TL::FileManager::reportCacheStats(std::size_t nEvents) const {
+  for (const auto ch : {mainChain(), weightsChain(), particleLevelChain(), truthChain()}) {
+    if (ch == nullptr || ch->GetCurrentFile() == nullptr) {
+      continue;
+    }
+    const TTreeCache* cache = ch->GetReadCache(ch->GetCurrentFile());
+    if (cache == nullptr) {
+      logger()->info("Chain {}: no TTreeCache", ch->GetName());
+      continue;
+    }
+    logger()->info(
+        "Chain {}: cache hit rate {:.3f}, {:.3f} of the prefetched baskets used, {} cached "
+        "read calls ({:.1f} MB), {} uncached read calls ({:.1f} MB)",
+        ch->GetName(), cache->GetEfficiencyRel(), cache->GetEfficiency(),
+        cache->GetReadCalls(), cache->GetBytesRead() / 1.0e6, cache->GetNoCacheReadCalls(),
+        cache->GetNoCacheBytesRead() / 1.0e6);
+  }
+  if (m_staging != nullptr) {
+    m_staging->report();
+  }
+  if (m_prefetcher != nullptr) {
+    m_prefetcher->report();
+  }
+  const Int_t readCalls = TFile::GetFileReadCalls();
+  logger()->info("{} read calls ({:.2f} per event), {:.1f} MB read", readCalls,
+                 static_cast<double>(readCalls) / std::max<std::size_t>(nEvents, 1),
+                 TFile::GetFileBytesRead() / 1.0e6);
+}
+
+void TL::FileManager::setCacheMemoryBudget(Long64_t bytes) {
+  m_cacheBudget = std::max<Long64_t>(bytes, 0);
+}
+
+void TL::FileManager::rebalanceCaches(const std::vector<Chain>& chains) const {
+  if (m_cacheBudget == 0) {
+    return;
+  }
+  std::map<Chain, Long64_t> readVolume;
+  Long64_t totalVolume = 0;
+  for (const auto c : chains) {
+    if (chain(c) == nullptr) {
+      continue;
+    }
+    const Long64_t bytesRead = chainBytesRead(chain(c));
+    // the counters start again if the cache is recreated
+    const Long64_t previous = m_bytesReadAtRebalance[c];
+    readVolume[c] = bytesRead >= previous ? bytesRead - previous : bytesRead;
+    m_bytesReadAtRebalance[c] = bytesRead;
+    totalVolume += readVolume[c];
+  }
+  if (readVolume.empty()) {
+    return;
+  }
+
+  const Long64_t nChains = readVolume.size();
+  const Long64_t minSize = std::min<Long64_t>(1000000, m_cacheBudget / (2 * nChains));
+  const Long64_t shared = m_cacheBudget - nChains * minSize;
+  for (const auto c : {Chain::Main, Chain::Weights, Chain::ParticleLevel, Chain::Truth}) {
+    TChain* ch = chain(c);
+    if (ch == nullptr || ch->GetCurrentFile() == nullptr) {
+      continue;
+    }
+    Long64_t size = 0;
+    auto itr = readVolume.find(c);
+    if (itr != std::end(readVolume)) {
+      const double fraction = totalVolume > 0
+                                  ? static_cast<double>(itr->second) / totalVolume
+                                  : 1.0 / nChains;
+      size = minSize + static_cast<Long64_t>(fraction * shared);
+    }
+    const TTreeCache* cache = ch->GetReadCache(ch->GetCurrentFile());
+    const Long64_t current = cache == nullptr ? 0 : cache->GetBufferSize();
+    if (current == size ||
+        (current > 0 && size > 0 && std::abs(size - current) < current / 5)) {
+      continue;
+    }
+    ch->SetCacheSize(size);
+    logger()->debug("Chain {}: cache resized from {:.1f} to {:.1f} MB", ch->GetName(),
+                    current / 1.0e6, size / 1.0e6);
+  }
+}
+
+void TL::FileManager::enableFilePrefetch() { m_prefetchFiles = true; }
+
+void TL::FileManager::prefetchNextFile(const TChain* chain) const {
+  if (not m_prefetchFiles || chain == nullptr) {
+    return;
+  }
+  const Int_t next = chain->GetTreeNumber() + 1;
+  if (next <= 0 || next >= chain->GetListOfFiles()->GetEntries()) {
+    return;
+  }
+  auto element = chain->GetListOfFiles()->At(next);
+  prefetchFile(element->GetTitle(), element->GetName(), chain);
+}
+
+void TL::FileManager::prefetchFile(const std::string& fileName, const std::string& treeName,
+                                   const TChain* chain) const {
+  if (not m_prefetchFiles) {
+    return;
+  }
+  if (m_prefetcher == nullptr) {
+    m_prefetcher = std::make_unique<TL::FilePrefetcher>();
+  }
+  m_prefetcher->prefetch(fileName, treeName, branchStatusOf(chain));
+}
+
+void TL::FileManager::enableStaging(const std::string& directory, uint64_t maxBytes,
+                                    std::size_t depth) {
+  m_staging = std::make_unique<TL::StagingCache>(directory, maxBytes);
+  m_stagingDepth = depth;
+}
+
+std::string TL::FileManager::inputPath(const std::string& fileName) const {
+  return m_staging == nullptr ? fileName : m_staging->resolve(fileName);
+}
+
+void TL::FileManager::stageUpcoming(const TChain* chain) const {
+  if (m_staging == nullptr || m_rootChain == nullptr) {
+    return;
+  }
+  // before the loop (null chain) stage from the first file
+  const Int_t first = chain == nullptr ? 0 : std::max(chain->GetTreeNumber() + 1, 0);
+  const Int_t nFiles = m_rootChain->GetListOfFiles()->GetEntries();
+  const Int_t last = std::min<Int_t>(first + m_stagingDepth, nFiles);
+  for (Int_t i = first; i < last; ++i) {
+    const std::string source = m_rootChain->GetListOfFiles()->At(i)->GetTitle();
+    const auto path = m_staging->resolve(source);
+    if (path == source) {
+      m_staging->stage(source);
+      continue;
+    }
+    // none of the chains has opened this file yet
+    for (const auto ch :
+         {mainChain(), weightsChain(), particleLevelChain(), truthChain()}) {
+      if (ch == nullptr || i >= ch->GetListOfFiles()->GetEntries()) {
+        continue;
+      }
+      auto element = static_cast<TChainElement*>(ch->GetListOfFiles()->At(i));
+      if (source == element->GetTitle()) {
+        element->SetTitle(path.c_str());
+      }
+    }
+    logger()->debug("Reading the local copy of {}", source);
+  }
+}
+
 TL::StatusCode TL::FileManager::initChain() {
   if (!m_rootChain) {
     m_rootChain = std::make_unique<TChain>(m_treeName.c_str());
@@ -190,13 +549,15 @@ void TL::FileManager::feedDir(const std::string& dirpath,
 
   for (auto const& filepath : m_fileNames) {
     logger()->info("Adding file: {}", fs::path(filepath).filename().string());
-    m_rootChain->AddFile(filepath.c_str());
-    m_rootWeightsChain->AddFile(filepath.c_str());
+    const auto path = inputPath(filepath);
+    m_rootChain->AddFile(path.c_str());
+    m_rootWeightsChain->AddFile(path.c_str());
     if (m_doParticleLevel) {
-      m_particleLevelChain->AddFile(filepath.c_str());
-      m_truthChain->AddFile(filepath.c_str());
+      m_particleLevelChain->AddFile(path.c_str());
+      m_truthChain->AddFile(path.c_str());
     }
   }
+  stageUpcoming(nullptr);
 
   // check for duplicate {[job number].[file number]} combos
   std::sort(std::begin(checkForDupes), std::end(checkForDupes));
@@ -245,14 +606,16 @@ void TL::FileManager::feedTxt(const std::string& txtfilename) {
     if (!line.empty()) {
       logger()->info("Adding file {}", line);
       m_fileNames.emplace_back(line);
-      m_rootChain->Add(line.c_str());
-      m_rootWeightsChain->Add(line.c_str());
+      const auto path = inputPath(line);
+      m_rootChain->Add(path.c_str());
+      m_rootWeightsChain->Add(path.c_str());
       if (m_doParticleLevel) {
-        m_particleLevelChain->AddFile(line.c_str());
-        m_truthChain->AddFile(line.c_str());
+        m_particleLevelChain->AddFile(path.c_str());
+        m_truthChain->AddFile(path.c_str());
       }
     }
   }
+  stageUpcoming(nullptr);
 }
 
 void TL::FileManager::feedRucio(const std::string& datasetName, const std::string& rse) {
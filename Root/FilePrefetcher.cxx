@@ -0,0 +1,140 @@
+/*! @file FilePrefetcher.cxx
+ *  @brief TL::FilePrefetcher class implementation
+ */
+
+// TL
+#include <TopLoop/Core/FilePrefetcher.h>
+
+// ROOT
+#include <TBranch.h>
+#include <TFile.h>
+#include <TLeaf.h>
+#include <TROOT.h>
+#include <TTree.h>
+
+// Boost
+#include <boost/algorithm/string/predicate.hpp>
+#include <boost/filesystem/operations.hpp>
+namespace fs = boost::filesystem;
+
+// C++
+#include <algorithm>
+#include <memory>
+
+// POSIX
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace {
+
+/// bytes read ahead at the start of a local file (first clusters)
+constexpr off_t localHeadBytes = 64000000;
+/// bytes read ahead at the end of a local file (keys, streamers, TTree metadata)
+constexpr off_t localTailBytes = 8000000;
+
+}  // namespace
+
+TL::FilePrefetcher::FilePrefetcher() : TL::Loggable("TL::FilePrefetcher") {
+  // remote files are opened on the background thread
+  ROOT::EnableThreadSafety();
+}
+
+TL::FilePrefetcher::~FilePrefetcher() { wait(); }
+
+bool TL::FilePrefetcher::isLocal(const std::string& fileName) {
+  if (boost::algorithm::starts_with(fileName, "file:")) {
+    return true;
+  }
+  return fileName.find("://") == std::string::npos;
+}
+
+void TL::FilePrefetcher::prefetch(
+    const std::string& fileName, const std::string& treeName,
+    const std::vector<std::pair<std::string, bool>>& branchStatus) {
+  if (fileName == m_lastFile) {
+    return;
+  }
+  if (m_pending.valid() &&
+      m_pending.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+    logger()->debug("Still warming up {}, not prefetching {}", m_lastFile, fileName);
+    m_nSkipped++;
+    return;
+  }
+  m_lastFile = fileName;
+  m_nStarted++;
+  logger()->debug("Prefetching {}", fileName);
+  if (isLocal(fileName)) {
+    m_pending = std::async(std::launch::async, [this, fileName] { warmLocal(fileName); });
+  }
+  else {
+    m_pending = std::async(std::launch::async, [this, fileName, treeName, branchStatus] {
+      warmRemote(fileName, treeName, branchStatus);
+    });
+  }
+}
+
+void TL::FilePrefetcher::wait() {
+  if (m_pending.valid()) {
+    m_pending.wait();
+  }
+}
+
+void TL::FilePrefetcher::report() const {
+  logger()->info("Prefetched {} files, {} requests skipped (previous one still running)",
+                 m_nStarted, m_nSkipped);
+}
+
+void TL::FilePrefetcher::warmLocal(const std::string& fileName) const {
+  const std::string path =
+      boost::algorithm::starts_with(fileName, "file:") ? fileName.substr(5) : fileName;
+  boost::system::error_code ec;
+  const auto size = static_cast<off_t>(fs::file_size(path, ec));
+  if (ec) {
+    logger()->debug("Cannot prefetch {}: {}", path, ec.message());
+    return;
+  }
+  const int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    logger()->debug("Cannot open {} for prefetching", path);
+    return;
+  }
+  // the kernel reads the pages in the background, nothing is copied here
+  ::posix_fadvise(fd, 0, std::min(size, localHeadBytes), POSIX_FADV_WILLNEED);
+  if (size > localHeadBytes) {
+    const off_t tailStart = std::max(localHeadBytes, size - localTailBytes);
+    ::posix_fadvise(fd, tailStart, size - tailStart, POSIX_FADV_WILLNEED);
+  }
+  ::close(fd);
+}
+
+void TL::FilePrefetcher::warmRemote(
+    const std::string& fileName, const std::string& treeName,
+    const std::vector<std::pair<std::string, bool>>& branchStatus) const {
+  std::unique_ptr<TFile> file(TFile::Open(fileName.c_str(), "READ"));
+  if (file == nullptr || file->IsZombie()) {
+    logger()->debug("Cannot open {} for prefetching", fileName);
+    return;
+  }
+  auto tree = dynamic_cast<TTree*>(file->Get(treeName.c_str()));
+  if (tree == nullptr || tree->GetEntries() == 0) {
+    return;
+  }
+  // read the baskets of the first cluster of the branches the loop
+  // reads in one go
+  for (const auto& status : branchStatus) {
+    tree->SetBranchStatus(status.first.c_str(), status.second);
+  }
+  auto clusterIter = tree->GetClusterIterator(0);
+  clusterIter();
+  tree->SetCacheSize(30000000);
+  tree->SetCacheEntryRange(0, clusterIter.GetNextEntry());
+  for (const auto obj : *(tree->GetListOfLeaves())) {
+    TBranch* branch = static_cast<TLeaf*>(obj)->GetBranch();
+    if (not branch->TestBit(TBranch::kDoNotProcess)) {
+      tree->AddBranchToCache(branch, false);
+    }
+  }
+  tree->StopCacheLearningPhase();
+  tree->GetEntry(0);
+  file->Close();
+}
@@ -0,0 +1,173 @@
+/*! @file IndexCache.cxx
+ *  @brief TL::IndexCache class implementation
+ */
+
+// TL
+#include <TopLoop/Core/IndexCache.h>
+
+// Boost
+#include <boost/filesystem/operations.hpp>
+#include <boost/filesystem/path.hpp>
+namespace fs = boost::filesystem;
+
+// C++
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+// POSIX
+#include <unistd.h>
+
+namespace {
+
+constexpr char cacheMagic[8] = {'T', 'L', 'I', 'D', 'X', '0', '0', '1'};
+
+struct CacheHeader {
+  char magic[8];
+  uint64_t fingerprint;
+  uint64_t nParticleAndReco;
+  uint64_t nParticleLevelOnly;
+  uint64_t nRecoLevelOnly;
+};
+
+void fnv1a(uint64_t& hash, const void* data, std::size_t size) {
+  auto bytes = static_cast<const unsigned char*>(data);
+  for (std::size_t i = 0; i < size; ++i) {
+    hash ^= bytes[i];
+    hash *= 1099511628211ULL;
+  }
+}
+
+void fnv1a(uint64_t& hash, const std::string& s) { fnv1a(hash, s.data(), s.size() + 1); }
+
+void hashFile(uint64_t& hash, const std::string& fileName) {
+  fnv1a(hash, fileName);
+  boost::system::error_code ec;
+  if (fs::is_regular_file(fileName, ec)) {
+    const uint64_t size = fs::file_size(fileName, ec);
+    const int64_t mtime = fs::last_write_time(fileName, ec);
+    fnv1a(hash, &size, sizeof(size));
+    fnv1a(hash, &mtime, sizeof(mtime));
+  }
+}
+
+template <typename T>
+bool readArray(std::ifstream& in, std::vector<T>& v, uint64_t n) {
+  v.resize(n);
+  in.read(reinterpret_cast<char*>(v.data()), n * sizeof(T));
+  return static_cast<bool>(in);
+}
+
+template <typename T>
+void writeArray(std::ofstream& out, const std::vector<T>& v) {
+  out.write(reinterpret_cast<const char*>(v.data()), v.size() * sizeof(T));
+}
+
+}  // namespace
+
+TL::IndexCache::IndexCache(const std::string& directory,
+                           const std::vector<std::string>& fileNames,
+                           const std::string& recoTreeName,
+                           const std::string& particleLevelTreeName)
+    : TL::Loggable("TL::IndexCache") {
+  m_fingerprint = fingerprint(fileNames, recoTreeName, particleLevelTreeName);
+  auto fileName = fmt::format("TL_index_{:016x}.bin", m_fingerprint);
+  m_path = (fs::path(directory) / fileName).string();
+}
+
+uint64_t TL::IndexCache::fingerprint(const std::vector<std::string>& fileNames,
+                                     const std::string& recoTreeName,
+                                     const std::string& particleLevelTreeName) {
+  uint64_t hash = 14695981039346656037ULL;
+  fnv1a(hash, recoTreeName);
+  fnv1a(hash, particleLevelTreeName);
+  for (const auto& fileName : fileNames) {
+    hashFile(hash, fileName);
+  }
+  return hash;
+}
+
+bool TL::IndexCache::load(std::vector<std::pair<uint64_t, uint64_t>>& particleAndReco,
+                          std::vector<uint64_t>& particleLevelOnly,
+                          std::vector<uint64_t>& recoLevelOnly) const {
+  std::ifstream in(m_path, std::ios::binary);
+  if (not in) {
+    logger()->info("No index cache file {}", m_path);
+    return false;
+  }
+  CacheHeader header;
+  in.read(reinterpret_cast<char*>(&header), sizeof(header));
+  if (not in || std::memcmp(header.magic, cacheMagic, sizeof(cacheMagic)) != 0 ||
+      header.fingerprint != m_fingerprint) {
+    logger()->warn("Ignoring invalid index cache file {}", m_path);
+    return false;
+  }
+  // the counts of a corrupted header must not size the vectors
+  boost::system::error_code ec;
+  const uint64_t fileSize = fs::file_size(m_path, ec);
+  uint64_t remaining = ec || fileSize < sizeof(header) ? 0 : fileSize - sizeof(header);
+  auto fits = [&remaining](uint64_t n, std::size_t elementSize) {
+    if (n > remaining / elementSize) {
+      return false;
+    }
+    remaining -= n * elementSize;
+    return true;
+  };
+  if (ec || not(fits(header.nParticleAndReco, sizeof(std::pair<uint64_t, uint64_t>)) &&
+                   fits(header.nParticleLevelOnly, sizeof(uint64_t)) &&
+                   fits(header.nRecoLevelOnly, sizeof(uint64_t))) ||
+      remaining != 0) {
+    logger()->warn("Ignoring index cache file {}, its header does not match its size",
+                   m_path);
+    return false;
+  }
+  if (not(readArray(in, particleAndReco, header.nParticleAndReco) &&
+          readArray(in, particleLevelOnly, header.nParticleLevelOnly) &&
+          readArray(in, recoLevelOnly, header.nRecoLevelOnly))) {
+    logger()->warn("Ignoring truncated index cache file {}", m_path);
+    particleAndReco.clear();
+    particleLevelOnly.clear();
+    recoLevelOnly.clear();
+    return false;
+  }
+  return true;
+}
+
+TL::StatusCode TL::IndexCache::save(
+    const std::vector<std::pair<uint64_t, uint64_t>>& particleAndReco,
+    const std::vector<uint64_t>& particleLevelOnly,
+    const std::vector<uint64_t>& recoLevelOnly) const {
+  // write to a temporary file and rename it, so that concurrent jobs
+  // never read a partially written cache
+  const std::string tmpPath = fmt::format("{}.{}.tmp", m_path, ::getpid());
+  std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+  if (not out) {
+    logger()->error("Cannot write the index cache file {}", tmpPath);
+    std::remove(tmpPath.c_str());
+    return TL::StatusCode::FAILURE;
+  }
+  CacheHeader header;
+  std::memcpy(header.magic, cacheMagic, sizeof(cacheMagic));
+  header.fingerprint = m_fingerprint;
+  header.nParticleAndReco = particleAndReco.size();
+  header.nParticleLevelOnly = particleLevelOnly.size();
+  header.nRecoLevelOnly = recoLevelOnly.size();
+  out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  writeArray(out, particleAndReco);
+  writeArray(out, particleLevelOnly);
+  writeArray(out, recoLevelOnly);
+  // closing flushes the last bytes, which can fail as well
+  out.close();
+  if (not out) {
+    logger()->error("Cannot write the index cache file {}", tmpPath);
+    std::remove(tmpPath.c_str());
+    return TL::StatusCode::FAILURE;
+  }
+  if (std::rename(tmpPath.c_str(), m_path.c_str()) != 0) {
+    logger()->error("Cannot move the index cache file to {}", m_path);
+    std::remove(tmpPath.c_str());
+    return TL::StatusCode::FAILURE;
+  }
+  logger()->info("Saved the reco <-> particle level indices to {}", m_path);
+  return TL::StatusCode::SUCCESS;
+}
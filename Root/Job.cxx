@@ -6,12 +6,50 @@
 
 // TL
 #include <TopLoop/Core/Algorithm.h>
+#include <TopLoop/Core/Checkpointer.h>
+#include <TopLoop/Core/ClusterPartitioner.h>
+#include <TopLoop/Core/ClusterReadAhead.h>
+#include <TopLoop/Core/EventIndexJoin.h>
 #include <TopLoop/Core/FileManager.h>
+#include <TopLoop/Core/IndexCache.h>
 #include <TopLoop/Core/Job.h>
 #include <TopLoop/Core/Utils.h>
 #include <TopLoop/tqdm/tqdm.h>
 
-#include <TTreeIndex.h>
+#include <TFile.h>
+#include <TH1.h>
+#include <TParameter.h>
+#include <TROOT.h>
+
+// C++
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <iterator>
+#include <set>
+#include <thread>
+#include <tuple>
+
+namespace {
+
+/// the chains read by the event loop
+std::vector<TL::FileManager::Chain> loopChains(TL::LoopType loopType) {
+  using Chain = TL::FileManager::Chain;
+  switch (loopType) {
+    case TL::LoopType::RecoStandard:
+    case TL::LoopType::RecoOnly:
+      return {Chain::Main};
+    case TL::LoopType::RecoWithParticle:
+      return {Chain::Main, Chain::ParticleLevel, Chain::Truth};
+    case TL::LoopType::ParticleAll:
+    case TL::LoopType::ParticleOnly:
+      return {Chain::ParticleLevel, Chain::Truth};
+  }
+  return {};
+}
+
+}  // namespace
 
 TL::Job::Job() : TL::Loggable("TL::Job") {}
 
@@ -23,6 +61,19 @@ TL::StatusCode TL::Job::setAlgorithm(std::unique_ptr<TL::Algorithm> alg) {
   return TL::StatusCode::SUCCESS;
 }
 
+TL::StatusCode TL::Job::addAlgorithm(std::unique_ptr<TL::Algorithm> alg) {
+  if (alg == nullptr) {
+    return TL::StatusCode::FAILURE;
+  }
+  if (m_algorithm == nullptr) {
+    m_algorithm = std::move(alg);
+  }
+  else {
+    m_coAlgorithms.push_back(std::move(alg));
+  }
+  return TL::StatusCode::SUCCESS;
+}
+
 TL::StatusCode TL::Job::setFileManager(std::unique_ptr<TL::FileManager> fm) {
   if (fm == nullptr) {
     return TL::StatusCode::FAILURE;
@@ -31,44 +82,184 @@ TL::StatusCode TL::Job::setFileManager(std::unique_ptr<TL::FileManager> fm) {
   return TL::StatusCode::SUCCESS;
 }
 
+TL::StatusCode TL::Job::setAlgorithmFactory(AlgorithmFactory factory) {
+  if (not factory) {
+    return TL::StatusCode::FAILURE;
+  }
+  m_algorithmFactory = std::move(factory);
+  return TL::StatusCode::SUCCESS;
+}
+
 TL::StatusCode TL::Job::run() {
+  if (m_algorithm == nullptr && m_algorithmFactory) {
+    m_algorithm = m_algorithmFactory();
+  }
+  if (m_algorithm == nullptr) {
+    logger()->error("Job doesn't have an algorithm to run");
+    return TL::StatusCode::FAILURE;
+  }
+
   if (m_algorithm->isData() && m_loopType != LoopType::RecoStandard) {
     logger()->error(
         "Algorithm is processing data, which can only work with a RecoStandard LoopType");
     return TL::StatusCode::FAILURE;
   }
 
+  if (m_batchSize > 0 && m_loopType != LoopType::RecoStandard) {
+    logger()->error(
+        "Batch mode (setBatchSize, executeBatch) is only supported by the RecoStandard "
+        "loop");
+    return TL::StatusCode::FAILURE;
+  }
+  if (m_autoPruneEvents > 0 && (m_batchSize > 0 || m_nThreads > 1)) {
+    logger()->error(
+        "Automatic branch pruning is only supported by the single threaded loops without "
+        "batch mode");
+    return TL::StatusCode::FAILURE;
+  }
+
+  if (m_fm == nullptr) {
+    logger()->error("Job doesn't have a FileManager");
+    return TL::StatusCode::FAILURE;
+  }
+  disableUnusedBranches();
+
+  const bool multiTree = m_fm->treeNames().size() > 1;
+  if (multiTree && (m_loopType != LoopType::RecoStandard || m_nThreads > 1 ||
+                    m_nShards > 1 || m_rangeFirst > 0 ||
+                    m_rangeLast < std::numeric_limits<uint64_t>::max())) {
+    logger()->error(
+        "Several trees per pass are only supported by the single threaded RecoStandard "
+        "loop over full samples");
+    return TL::StatusCode::FAILURE;
+  }
+  if (m_readAheadDepth > 0 && (m_nThreads > 1 || multiTree)) {
+    logger()->error(
+        "Read-ahead is only supported by the single threaded loops over one tree per pass");
+    return TL::StatusCode::FAILURE;
+  }
+
+  if (m_resume && m_checkpointPath.empty()) {
+    logger()->error("Resuming from a checkpoint requires enableCheckpointing");
+    return TL::StatusCode::FAILURE;
+  }
+  if (not m_checkpointPath.empty() &&
+      (m_nThreads > 1 || multiTree ||
+       not(m_loopType == LoopType::RecoStandard || m_loopType == LoopType::ParticleAll))) {
+    logger()->error(
+        "Checkpointing is only supported by the single threaded RecoStandard and "
+        "ParticleAll loops");
+    return TL::StatusCode::FAILURE;
+  }
+
+  // before any chain creates its cache
+  configureImplicitMT();
+
+  if (m_nThreads > 1) {
+    if (not m_coAlgorithms.empty()) {
+      logger()->error("Multiple algorithms cannot be run on multiple threads");
+      return TL::StatusCode::FAILURE;
+    }
+    return runMultiThreaded();
+  }
+
   // indices required for loops that are not standard reco or all particle
   if (not(m_loopType == LoopType::RecoStandard || m_loopType == LoopType::ParticleAll)) {
     TL_CHECK(constructIndices());
   }
 
-  TL_CHECK(m_algorithm->setFileManager(std::move(m_fm)));
-  TL_CHECK(m_algorithm->init());
-  if (not m_algorithm->initCalled()) {
-    logger()->error("You didn't call TL::Algorithm::init()");
-    logger()->error("in your algorithm's init() function");
-    logger()->error("This is a required line!");
-    return TL::StatusCode::FAILURE;
+  // the slice of the chain driving the loop
+  const bool particleDriven =
+      m_loopType == LoopType::ParticleAll || m_loopType == LoopType::ParticleOnly;
+  TL::ClusterPartitioner partitioner;
+  uint64_t firstEntry = 0;
+  uint64_t lastEntry = 0;
+  std::tie(firstEntry, lastEntry) = loopEntryRange(
+      particleDriven ? m_fm->particleLevelChain() : m_fm->mainChain(), partitioner);
+  applyEntryRangeToIndices(firstEntry, lastEntry);
+  // read the reco tree sequentially (unless the user opted out)
+  if (m_loopType == LoopType::RecoWithParticle) {
+    TL_CHECK(orderParticleAndReco());
+  }
+
+  // the branches must be connected on first use to learn which are used
+  if (m_autoPruneEvents > 0) {
+    m_algorithm->enableLazyBranchConnection();
+    for (auto& alg : m_coAlgorithms) {
+      alg->enableLazyBranchConnection();
+    }
   }
-  TL_CHECK(m_algorithm->setupOutput());
+  TL_CHECK(m_algorithm->setFileManager(std::move(m_fm)));
+  TL_CHECK(initAlgorithm(m_algorithm.get()));
+  TL_CHECK(initCoAlgorithms());
   m_algorithm->reader()->Restart();
+  // the cache type must be chosen before the policies configure it
+  configureParallelUnzip(m_algorithm->fileManager());
+  TL_CHECK(m_algorithm->fileManager()->applyCachePolicies());
+
+  // restrict the bookkeeping to the requested slice of the chain
+  if (particleDriven) {
+    m_algorithm->m_totalParticleLevelEntries = lastEntry - firstEntry;
+  }
+  else {
+    m_algorithm->m_totalEntries = lastEntry - firstEntry;
+  }
+  if (m_loopType == LoopType::RecoWithParticle) {
+    m_algorithm->m_totalEntries = m_particleAndReco.size();
+  }
+  else if (m_loopType == LoopType::ParticleOnly) {
+    m_algorithm->m_totalParticleLevelEntries = m_particleLevelOnly.size();
+  }
+  else if (m_loopType == LoopType::RecoOnly) {
+    m_algorithm->m_totalEntries = m_recoLevelOnly.size();
+  }
+
+  m_algorithm->fileManager()->rebalanceCaches(loopChains(m_loopType));
+
+  m_algorithm->m_truthAvailable =
+      m_loopType != LoopType::RecoStandard && m_loopType != LoopType::RecoOnly;
+  syncCoAlgorithms();
+
+  // the writes happen on a separate thread
+  const uint64_t sliceFirst = firstEntry;
+  std::unique_ptr<TL::Checkpointer> checkpointer{nullptr};
+  if (not m_checkpointPath.empty()) {
+    ROOT::EnableThreadSafety();
+    checkpointer = std::make_unique<TL::Checkpointer>(
+        m_checkpointPath, std::chrono::seconds(m_checkpointInterval));
+    if (m_resume) {
+      TL_CHECK(restoreCheckpoint(*checkpointer, firstEntry, lastEntry));
+    }
+  }
+
+  if (m_readAheadDepth > 0) {
+    m_readAhead = std::make_shared<TL::ClusterReadAhead>(m_readAheadDepth);
+  }
 
   tqdm bar;
   bar.set_theme_braille_spin();
 
   // if particle level is not enabled, do the standard loop over the
   // normal tree.
-  if (m_loopType == LoopType::RecoStandard) {
-    while (m_algorithm->reader()->Next()) {
+  if (m_loopType == LoopType::RecoStandard && multiTree) {
+    TL_CHECK(loopTreesPerFile());
+  }
+  else if (m_loopType == LoopType::RecoStandard) {
+    if (firstEntry < lastEntry) {
+      m_algorithm->reader()->SetEntriesRange(firstEntry, lastEntry);
+    }
+    while (firstEntry < lastEntry && m_algorithm->reader()->Next()) {
       if (m_useProgressBar) {
         bar.progress(m_algorithm->m_eventCounter, m_algorithm->m_totalEntries);
       }
       else {
         printProgress(5, m_algorithm->m_totalEntries, m_algorithm->m_eventCounter);
       }
-      TL_CHECK(m_algorithm->execute());
+      TL_CHECK(executeEvent());
+      TL_CHECK(maybeCheckpoint(checkpointer.get(), sliceFirst, lastEntry,
+                               m_algorithm->reader()->GetCurrentEntry() + 1));
     }
+    TL_CHECK(flushBatches());
     std::cout << std::endl;
   }  // end if standard (not using particle level)
 
@@ -79,11 +270,9 @@ TL::StatusCode TL::Job::run() {
     // first, if we want particle level only (i.e. events that didn't
     // end up in reco tree
     if (m_loopType == LoopType::ParticleOnly) {
-      m_algorithm->m_truthAvailable = true;
       logger()->info("Entering particle level only loop");
       for (const auto idx : m_particleLevelOnly) {
-        m_algorithm->particleLevelReader()->SetEntry(idx);
-        m_algorithm->truthReader()->SetEntry(idx);
+        setParticleLevelEntry(idx);
         if (m_useProgressBar) {
           bar.progress(m_algorithm->m_eventCounter,
                        m_algorithm->m_totalParticleLevelEntries);
@@ -92,15 +281,19 @@ TL::StatusCode TL::Job::run() {
           printProgress(5, m_algorithm->m_totalParticleLevelEntries,
                         m_algorithm->m_eventCounter);
         }
-        TL_CHECK(m_algorithm->execute());
+        TL_CHECK(executeEvent());
       }
     }  // end if particle level only
 
     // next, we do all particle level, agnostic to reco information
     else if (m_loopType == LoopType::ParticleAll) {
-      m_algorithm->m_truthAvailable = true;
       logger()->info("Entering all particle level loop");
-      while (m_algorithm->particleLevelReader()->Next() &&
+      if (firstEntry < lastEntry) {
+        m_algorithm->truthReader()->Restart();
+        m_algorithm->particleLevelReader()->SetEntriesRange(firstEntry, lastEntry);
+        m_algorithm->truthReader()->SetEntriesRange(firstEntry, lastEntry);
+      }
+      while (firstEntry < lastEntry && m_algorithm->particleLevelReader()->Next() &&
              m_algorithm->truthReader()->Next()) {
         if (m_useProgressBar) {
           bar.progress(m_algorithm->m_eventCounter,
@@ -110,17 +303,17 @@ TL::StatusCode TL::Job::run() {
           printProgress(5, m_algorithm->m_totalParticleLevelEntries,
                         m_algorithm->m_eventCounter);
         }
-        TL_CHECK(m_algorithm->execute());
+        TL_CHECK(executeEvent());
+        TL_CHECK(maybeCheckpoint(checkpointer.get(), sliceFirst, lastEntry,
+                                 m_algorithm->particleLevelReader()->GetCurrentEntry() + 1));
       }
     }  // end if all particle level
 
     // finally, we do reco and particle info together
     else if (m_loopType == LoopType::RecoWithParticle) {
-      m_algorithm->m_truthAvailable = true;
       logger()->info("Entering loop over reco _and_  particle level information");
-      for (const auto idx : m_particleAndReco) {
-        m_algorithm->particleLevelReader()->SetEntry(std::get<0>(idx));
-        m_algorithm->truthReader()->SetEntry(std::get<0>(idx));
+      for (const auto& idx : m_particleAndReco) {
+        setParticleLevelEntry(std::get<0>(idx));
         m_algorithm->reader()->SetEntry(std::get<1>(idx));
         if (m_useProgressBar) {
           bar.progress(m_algorithm->m_eventCounter, m_algorithm->m_totalEntries);
@@ -128,14 +321,24 @@ TL::StatusCode TL::Job::run() {
         else {
           printProgress(5, m_algorithm->m_totalEntries, m_algorithm->m_eventCounter);
         }
-        TL_CHECK(m_algorithm->execute());
+        TL_CHECK(executeEvent());
       }
     }  // end if reco and particle
 
+    // events which are in reco but not in particle level
     else if (m_loopType == LoopType::RecoOnly) {
-      logger()->warn("RecoOnly not supported yet. Exiting.");
-      std::exit(EXIT_SUCCESS);
-    }
+      logger()->info("Entering reco only loop");
+      for (const auto idx : m_recoLevelOnly) {
+        m_algorithm->reader()->SetEntry(idx);
+        if (m_useProgressBar) {
+          bar.progress(m_algorithm->m_eventCounter, m_algorithm->m_totalEntries);
+        }
+        else {
+          printProgress(5, m_algorithm->m_totalEntries, m_algorithm->m_eventCounter);
+        }
+        TL_CHECK(executeEvent());
+      }
+    }  // end if reco only
 
     else {
       logger()->error("Someone went wrong with the LoopType");
@@ -144,14 +347,733 @@ TL::StatusCode TL::Job::run() {
 
   }  // end if particle level enabled
 
+  if (checkpointer != nullptr) {
+    checkpointer->wait();
+    checkpointer->report();
+  }
+  if (m_readAhead != nullptr) {
+    m_readAhead->report();
+    m_readAhead.reset();
+  }
+  if (m_autoPruneEvents > 0) {
+    logReadBranches();
+  }
+  m_algorithm->fileManager()->reportCacheStats(m_algorithm->m_eventCounter);
+  TL_CHECK(finishAlgorithms());
+  if (checkpointer != nullptr) {
+    checkpointer->remove();
+  }
+  return TL::StatusCode::SUCCESS;
+}
+
+TL::StatusCode TL::Job::initAlgorithm(TL::Algorithm* alg) const {
+  TL_CHECK(alg->init());
+  if (not alg->initCalled()) {
+    logger()->error("You didn't call TL::Algorithm::init()");
+    logger()->error("in your algorithm's init() function");
+    logger()->error("This is a required line!");
+    return TL::StatusCode::FAILURE;
+  }
+  TL_CHECK(alg->setupOutput());
+  alg->m_eventBatch.reserve(m_batchSize);
+  return TL::StatusCode::SUCCESS;
+}
+
+TL::StatusCode TL::Job::loopTreesPerFile() {
+  const auto fm = m_algorithm->fileManager();
+  TChain* chain = fm->mainChain();
+  const auto& treeNames = fm->treeNames();
+  auto reader = m_algorithm->reader();
+
+  std::vector<std::string> fileNames;
+  for (const auto obj : *(chain->GetListOfFiles())) {
+    fileNames.emplace_back(obj->GetTitle());
+  }
+  logger()->info("Entering loop over {} trees in each of {} files", treeNames.size(),
+                 fileNames.size());
+
+  tqdm bar;
+  bar.set_theme_braille_spin();
+  std::size_t nFilesDone = 0;
+  for (std::size_t ifile = 0; ifile < fileNames.size(); ++ifile) {
+    const auto& fileName = fileNames[ifile];
+    if (ifile + 1 < fileNames.size()) {
+      fm->prefetchFile(fileNames[ifile + 1], treeNames.front(), chain);
+    }
+    // each file is opened once, all of the trees are read from it
+    std::unique_ptr<TFile> file(TFile::Open(fileName.c_str(), "READ"));
+    if (file == nullptr || file->IsZombie()) {
+      logger()->error("Cannot open {}", fileName);
+      return TL::StatusCode::FAILURE;
+    }
+    for (const auto& treeName : treeNames) {
+      auto tree = dynamic_cast<TTree*>(file->Get(treeName.c_str()));
+      if (tree == nullptr) {
+        logger()->warn("No tree {} in {}, skipping", treeName, fileName);
+        continue;
+      }
+      fm->applyBranchStatus(tree);
+      // the branches stay connected, the reader only changes its tree
+      reader->SetTree(tree);
+      // bulk columns must reconnect, the tree may reuse a freed address
+      m_algorithm->setCurrentTree(treeName);
+      m_algorithm->m_readerTreeChanges++;
+      for (auto& alg : m_coAlgorithms) {
+        alg->setCurrentTree(treeName);
+        alg->m_readerTreeChanges++;
+      }
+      while (reader->Next()) {
+        TL_CHECK(executeEvent());
+      }
+      TL_CHECK(flushBatches());
+    }
+    // the reader must not keep a tree of a file which is closed
+    reader->SetTree(chain);
+    m_algorithm->m_readerTreeChanges++;
+    for (auto& alg : m_coAlgorithms) {
+      alg->m_readerTreeChanges++;
+    }
+    nFilesDone++;
+    if (m_useProgressBar) {
+      bar.progress(nFilesDone, fileNames.size());
+    }
+    else {
+      logger()->info(" -- File {}/{} done", nFilesDone, fileNames.size());
+    }
+  }
+  std::cout << std::endl;
+  return TL::StatusCode::SUCCESS;
+}
+
+TL::StatusCode TL::Job::initCoAlgorithms() {
+  for (auto& alg : m_coAlgorithms) {
+    TL_CHECK(alg->shareInput(*m_algorithm));
+    TL_CHECK(initAlgorithm(alg.get()));
+  }
+  if (not m_coAlgorithms.empty()) {
+    logger()->info("Running {} algorithms over the same input", m_coAlgorithms.size() + 1);
+  }
+  return TL::StatusCode::SUCCESS;
+}
+
+void TL::Job::disableUnusedBranches() const {
+  // the branches no algorithm reads: the intersection of the lists
+  std::vector<std::string> unused = m_algorithm->m_unusedBranches;
+  std::sort(std::begin(unused), std::end(unused));
+  for (const auto& alg : m_coAlgorithms) {
+    std::vector<std::string> other = alg->m_unusedBranches;
+    std::sort(std::begin(other), std::end(other));
+    std::vector<std::string> common;
+    std::set_intersection(std::begin(unused), std::end(unused), std::begin(other),
+                          std::end(other), std::back_inserter(common));
+    unused = std::move(common);
+  }
+  if (not unused.empty()) {
+    logger()->info("Disabling {} branches unused by the algorithm(s)", unused.size());
+    m_fm->disableBranches(unused);
+  }
+}
+
+void TL::Job::syncCoAlgorithms() {
+  for (auto& alg : m_coAlgorithms) {
+    alg->m_totalEntries = m_algorithm->m_totalEntries;
+    alg->m_totalParticleLevelEntries = m_algorithm->m_totalParticleLevelEntries;
+    alg->m_truthAvailable = m_algorithm->m_truthAvailable;
+  }
+}
+
+TL::StatusCode TL::Job::executeEvent() {
+  const auto fm = m_algorithm->fileManager();
+  const TChain* chain = fm->chain(loopChains(m_loopType).front());
+  // before the algorithms read the entry's baskets
+  if (m_readAhead != nullptr) {
+    m_readAhead->update(chain);
+  }
+  if (m_batchSize > 0) {
+    TL_CHECK(batchStep(m_algorithm.get()));
+    for (auto& alg : m_coAlgorithms) {
+      TL_CHECK(batchStep(alg.get()));
+    }
+  }
+  else {
+    TL_CHECK(m_algorithm->execute());
+    for (auto& alg : m_coAlgorithms) {
+      TL_CHECK(alg->execute());
+    }
+  }
+  // as soon as the loop enters a new file: stage and warm up the next
+  // files, and split the cache budget by what the previous file read
+  if (chain->GetTreeNumber() != m_loopTreeNumber) {
+    m_loopTreeNumber = chain->GetTreeNumber();
+    fm->stageUpcoming(chain);
+    fm->prefetchNextFile(chain);
+    fm->rebalanceCaches(loopChains(m_loopType));
+  }
+  if (m_autoPruneEvents > 0) {
+    autoPruneStep();
+  }
+  return TL::StatusCode::SUCCESS;
+}
+
+void TL::Job::autoPruneStep() {
+  if (not m_branchesPruned) {
+    if (++m_nAutoPruneSeen == m_autoPruneEvents) {
+      pruneUnusedBranches();
+    }
+    return;
+  }
+  // a branch used for the first time after the pruning is enabled
+  // again on the reader's tree; make sure the chain keeps it enabled
+  // (the two differ when the trees of each file are read in turn)
+  TChain* chain = m_algorithm->fileManager()->mainChain();
+  auto restore = [chain](TL::Algorithm* alg) {
+    for (const auto& name : alg->m_reenabledBranches) {
+      chain->SetBranchStatus(name.c_str(), 1);
+      chain->AddBranchToCache(name.c_str(), true);
+    }
+    alg->m_reenabledBranches.clear();
+  };
+  restore(m_algorithm.get());
+  for (auto& alg : m_coAlgorithms) {
+    restore(alg.get());
+  }
+}
+
+void TL::Job::pruneUnusedBranches() {
+  m_branchesPruned = true;
+  // the branches connected by any algorithm, to any of the readers
+  std::set<std::string> used = m_algorithm->m_connectedBranches;
+  for (const auto& alg : m_coAlgorithms) {
+    used.insert(std::begin(alg->m_connectedBranches), std::end(alg->m_connectedBranches));
+  }
+  // the readers are shared with the co-algorithms
+  const auto fm = m_algorithm->fileManager();
+  const std::vector<std::pair<TChain*, TTreeReader*>> inputs{
+      {fm->mainChain(), m_algorithm->reader().get()},
+      {fm->particleLevelChain(), m_algorithm->particleLevelReader().get()},
+      {fm->truthChain(), m_algorithm->truthReader().get()}};
+  for (const auto& input : inputs) {
+    TChain* chain = input.first;
+    TTreeReader* reader = input.second;
+    if (chain == nullptr || reader == nullptr) {
+      continue;
+    }
+    // the reader only sets up its proxies when it loads an entry
+    if (reader->GetCurrentEntry() < 0) {
+      logger()->info("Chain {}: not read in the first {} events, nothing disabled",
+                     chain->GetName(), m_autoPruneEvents);
+      continue;
+    }
+    TTree* tree = reader->GetTree();
+    std::size_t nPruned = 0;
+    for (const auto obj : *(tree->GetListOfBranches())) {
+      const char* name = obj->GetName();
+      if (not tree->GetBranchStatus(name) || used.count(name) > 0) {
+        continue;
+      }
+      chain->SetBranchStatus(name, 0);
+      chain->DropBranchFromCache(name, true);
+      if (tree != chain) {
+        tree->SetBranchStatus(name, 0);
+      }
+      nPruned++;
+    }
+    logger()->info("Chain {}: disabled {} branches unused in the first {} events",
+                   chain->GetName(), nPruned, m_autoPruneEvents);
+  }
+}
+
+void TL::Job::logReadBranches() const {
+  const auto fm = m_algorithm->fileManager();
+  for (TChain* chain : {fm->mainChain(), fm->particleLevelChain(), fm->truthChain()}) {
+    if (chain == nullptr || chain->GetListOfBranches() == nullptr) {
+      continue;
+    }
+    std::size_t nActive = 0;
+    std::string list;
+    for (const auto obj : *(chain->GetListOfBranches())) {
+      if (chain->GetBranchStatus(obj->GetName())) {
+        list += list.empty() ? obj->GetName() : std::string(", ") + obj->GetName();
+        nActive++;
+      }
+    }
+    logger()->info("Chain {}: {} active branches: {}", chain->GetName(), nActive, list);
+  }
+}
+
+TL::StatusCode TL::Job::flushBatches() {
+  TL_CHECK(flushBatch(m_algorithm.get()));
+  for (auto& alg : m_coAlgorithms) {
+    TL_CHECK(flushBatch(alg.get()));
+  }
+  return TL::StatusCode::SUCCESS;
+}
+
+TL::StatusCode TL::Job::finishAlgorithms() {
+  TL_CHECK(m_algorithm->finish());
+  for (auto& alg : m_coAlgorithms) {
+    TL_CHECK(alg->finish());
+  }
+  return TL::StatusCode::SUCCESS;
+}
+
+TL::StatusCode TL::Job::maybeCheckpoint(TL::Checkpointer* checkpointer,
+                                        uint64_t sliceFirst, uint64_t sliceLast,
+                                        uint64_t nextEntry) {
+  // in batch mode only checkpoint between two batches
+  if (checkpointer == nullptr || not checkpointer->due() ||
+      m_algorithm->m_eventBatch.size() > 0) {
+    return TL::StatusCode::SUCCESS;
+  }
+  auto start = std::chrono::steady_clock::now();
+  std::vector<TL::Algorithm*> algs{m_algorithm.get()};
+  for (auto& alg : m_coAlgorithms) {
+    algs.push_back(alg.get());
+  }
+  std::vector<std::unique_ptr<TList>> states;
+  // the lists own the copies, they must not also belong to a directory
+  const bool addDirectory = TH1::AddDirectoryStatus();
+  TH1::AddDirectory(false);
+  for (auto alg : algs) {
+    auto state = std::make_unique<TList>();
+    state->SetOwner(true);
+    auto sc = alg->checkpointState(*state);
+    for (const auto obj : *state) {
+      if (auto hist = dynamic_cast<TH1*>(obj)) {
+        hist->SetDirectory(nullptr);
+      }
+    }
+    if (sc.isFailure()) {
+      TH1::AddDirectory(addDirectory);
+      return sc;
+    }
+    state->Add(new TParameter<Long64_t>("TL_eventCounter", alg->m_eventCounter));
+    states.push_back(std::move(state));
+  }
+  TH1::AddDirectory(addDirectory);
+  checkpointer->save({sliceFirst, sliceLast, nextEntry}, std::move(states));
+  checkpointer->addSnapshotTime(std::chrono::steady_clock::now() - start);
+  return TL::StatusCode::SUCCESS;
+}
+
+TL::StatusCode TL::Job::restoreCheckpoint(TL::Checkpointer& checkpointer,
+                                          uint64_t& firstEntry, uint64_t lastEntry) {
+  if (not checkpointer.exists()) {
+    logger()->warn("No checkpoint {} to resume from, starting from the beginning",
+                   checkpointer.path());
+    return TL::StatusCode::SUCCESS;
+  }
+  TL::CheckpointProgress progress;
+  std::vector<std::unique_ptr<TList>> states;
+  TL_CHECK(checkpointer.load(progress, states));
+  if (progress.firstEntry != firstEntry || progress.lastEntry != lastEntry ||
+      states.size() != m_coAlgorithms.size() + 1) {
+    logger()->error("The checkpoint {} was not written by this job configuration",
+                    checkpointer.path());
+    return TL::StatusCode::FAILURE;
+  }
+
+  std::vector<TL::Algorithm*> algs{m_algorithm.get()};
+  for (auto& alg : m_coAlgorithms) {
+    algs.push_back(alg.get());
+  }
+  for (std::size_t i = 0; i < algs.size(); ++i) {
+    auto counter =
+        dynamic_cast<TParameter<Long64_t>*>(states[i]->FindObject("TL_eventCounter"));
+    if (counter != nullptr) {
+      algs[i]->m_eventCounter = counter->GetVal();
+      delete states[i]->Remove(counter);
+    }
+    TL_CHECK(algs[i]->restoreState(*states[i]));
+  }
+  firstEntry = progress.nextEntry;
+  logger()->info("Resuming from entry {} ({} events already processed)", firstEntry,
+                 m_algorithm->m_eventCounter);
+  return TL::StatusCode::SUCCESS;
+}
+
+TL::StatusCode TL::Job::runMultiThreaded() {
+  if (not(m_loopType == LoopType::RecoStandard || m_loopType == LoopType::ParticleAll)) {
+    logger()->error("Only RecoStandard and ParticleAll loops can run on multiple threads");
+    return TL::StatusCode::FAILURE;
+  }
+  if (not m_algorithmFactory) {
+    logger()->error("Running on multiple threads requires an algorithm factory");
+    return TL::StatusCode::FAILURE;
+  }
+
+  const bool particleLoop = m_loopType == LoopType::ParticleAll;
+  TChain* loopChain = particleLoop ? m_fm->particleLevelChain() : m_fm->mainChain();
+  TL::ClusterPartitioner partitioner;
+  const auto entryRange = loopEntryRange(loopChain, partitioner);
+  const std::size_t totalEntries = entryRange.second - entryRange.first;
+  if (partitioner.nClusters() == 0) {
+    TL_CHECK(partitioner.scan(loopChain));
+  }
+
+  ROOT::EnableThreadSafety();
+
+  // the primary algorithm is worker 0, the others are replicas from
+  // the factory, each with its own FileManager (and therefore its own
+  // chains and TTreeReaders); the replicas are created first so that
+  // the job keeps its algorithm if that fails
+  std::vector<std::unique_ptr<TL::Algorithm>> algs(1);
+  algs.reserve(m_nThreads);
+  for (std::size_t i = 1; i < m_nThreads; ++i) {
+    auto replica = m_algorithmFactory();
+    auto fm = m_fm->clone();
+    if (replica == nullptr || fm == nullptr) {
+      logger()->error("Cannot create the algorithm replica for worker {}", i);
+      return TL::StatusCode::FAILURE;
+    }
+    replica->m_workerIndex = i;
+    TL_CHECK(replica->setFileManager(std::move(fm)));
+    algs.push_back(std::move(replica));
+  }
+  algs.front() = std::move(m_algorithm);
+  TL_CHECK(algs.front()->setFileManager(std::move(m_fm)));
+
+  // initialization is done serially, users are free to book
+  // histograms etc. in init() and setupOutput()
+  for (auto& alg : algs) {
+    TL_CHECK(initAlgorithm(alg.get()));
+    configureParallelUnzip(alg->fileManager());
+    TL_CHECK(alg->fileManager()->applyCachePolicies());
+  }
+
+  // a few cluster aligned units per worker; workers take the next
+  // unit when they are done with one, which balances the load
+  const std::size_t nWorkers = algs.size();
+  const auto units = partitioner.partition(4 * nWorkers, entryRange.first, entryRange.second);
+  logger()->info("Processing {} entries on {} threads", totalEntries, nWorkers);
+  partitioner.report(units);
+
+  std::atomic<std::size_t> nProcessed{0};
+  std::atomic<std::size_t> nRunning{nWorkers};
+  std::atomic<bool> failed{false};
+
+  std::atomic<std::size_t> nextUnit{0};
+  auto work = [&](TL::Algorithm* alg) {
+    std::vector<TTreeReader*> readers;
+    if (particleLoop) {
+      alg->m_truthAvailable = true;
+      readers = {alg->particleLevelReader().get(), alg->truthReader().get()};
+    }
+    else {
+      readers = {alg->reader().get()};
+    }
+    auto next = [&readers]() {
+      for (auto reader : readers) {
+        if (not reader->Next()) {
+          return false;
+        }
+      }
+      return true;
+    };
+    // the caches belong to this worker's chains; split its budget when
+    // it enters another file
+    const auto fm = alg->fileManager();
+    const TChain* workerChain = fm->chain(loopChains(m_loopType).front());
+    Int_t treeNumber = -1;
+    for (std::size_t iunit = nextUnit++; iunit < units.size(); iunit = nextUnit++) {
+      for (auto reader : readers) {
+        reader->SetEntriesRange(units[iunit].first, units[iunit].last);
+      }
+      while (not failed && next()) {
+        if (workerChain->GetTreeNumber() != treeNumber) {
+          treeNumber = workerChain->GetTreeNumber();
+          fm->rebalanceCaches(loopChains(m_loopType));
+        }
+        auto sc = m_batchSize > 0 ? batchStep(alg) : alg->execute();
+        if (sc.isFailure()) {
+          failed = true;
+        }
+        ++nProcessed;
+      }
+      // batches do not span units, entries in a batch are consecutive
+      if (flushBatch(alg).isFailure()) {
+        failed = true;
+      }
+    }
+    --nRunning;
+  };
+
+  // the workers share the cache memory budget
+  for (auto& alg : algs) {
+    alg->m_fm->setCacheMemoryBudget(alg->m_fm->cacheMemoryBudget() / nWorkers);
+    alg->fileManager()->rebalanceCaches(loopChains(m_loopType));
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  std::vector<std::thread> threads;
+  for (std::size_t i = 0; i < nWorkers; ++i) {
+    // the units are handed out dynamically, a worker's share of the
+    // entries is not known in advance
+    if (particleLoop) {
+      algs[i]->m_totalParticleLevelEntries = totalEntries;
+    }
+    else {
+      algs[i]->m_totalEntries = totalEntries;
+    }
+    algs[i]->reader()->Restart();
+    if (particleLoop) {
+      algs[i]->particleLevelReader()->Restart();
+      algs[i]->truthReader()->Restart();
+    }
+    threads.emplace_back(work, algs[i].get());
+  }
+
+  tqdm bar;
+  bar.set_theme_braille_spin();
+  std::size_t nextPrint = 0;
+  while (nRunning > 0) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    if (m_useProgressBar) {
+      bar.progress(nProcessed, totalEntries);
+    }
+    else if (nProcessed >= nextPrint) {
+      auto progress = std::round(100.0 * nProcessed / std::max<std::size_t>(totalEntries, 1));
+      logger()->info(" -- [{:3.0f}%] Event: {}", progress, nProcessed);
+      nextPrint += std::max<std::size_t>(totalEntries / 5, 1);
+    }
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  std::cout << std::endl;
+
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  logger()->info("Processed {} entries in {:.1f} s ({:.0f} entries/s)", nProcessed.load(),
+                 elapsed.count(), nProcessed / std::max(elapsed.count(), 1e-9));
+  if (failed) {
+    logger()->error("Algorithm execute() failed on one of the workers");
+    return TL::StatusCode::FAILURE;
+  }
+  // the chain statistics are the ones of the first worker, the read
+  // calls are counted over all of them
+  algs.front()->fileManager()->reportCacheStats(nProcessed);
+
+  for (std::size_t i = 1; i < nWorkers; ++i) {
+    TL_CHECK(algs.front()->merge(*algs[i]));
+  }
+  m_algorithm = std::move(algs.front());
+  algs.clear();
   TL_CHECK(m_algorithm->finish());
   return TL::StatusCode::SUCCESS;
 }
 
 void TL::Job::disableProgressBar() { m_useProgressBar = false; }
 
+void TL::Job::setNumThreads(std::size_t n) { m_nThreads = std::max<std::size_t>(n, 1); }
+
+void TL::Job::setBatchSize(std::size_t n) { m_batchSize = n; }
+
+void TL::Job::setNumIndexThreads(std::size_t n) { m_nIndexThreads = n; }
+
+void TL::Job::enableCheckpointing(const std::string& path, unsigned int seconds) {
+  m_checkpointPath = path;
+  m_checkpointInterval = seconds;
+}
+
+void TL::Job::resumeFromCheckpoint() { m_resume = true; }
+
+TL::StatusCode TL::Job::batchStep(TL::Algorithm* alg) const {
+  alg->m_eventBatch.fill(alg->reader()->GetCurrentEntry());
+  if (alg->m_eventBatch.size() >= m_batchSize) {
+    return flushBatch(alg);
+  }
+  return TL::StatusCode::SUCCESS;
+}
+
+TL::StatusCode TL::Job::flushBatch(TL::Algorithm* alg) const {
+  if (alg->m_eventBatch.size() == 0) {
+    return TL::StatusCode::SUCCESS;
+  }
+  auto sc = alg->executeBatch(alg->m_eventBatch);
+  alg->m_eventBatch.clear();
+  return sc;
+}
+
+void TL::Job::enableReadAhead(std::size_t depth) { m_readAheadDepth = depth; }
+
+void TL::Job::enableImplicitMT(std::size_t nThreads) {
+  m_implicitMT = true;
+  m_nImplicitMTThreads = nThreads;
+}
+
+void TL::Job::configureImplicitMT() const {
+  if (not m_implicitMT) {
+    return;
+  }
+#ifdef R__USE_IMT
+  if (ROOT::IsImplicitMTEnabled()) {
+    logger()->info("Using the existing implicit MT pool ({} threads)",
+                   ROOT::GetThreadPoolSize());
+    return;
+  }
+  const std::size_t total = m_nImplicitMTThreads > 0
+                                ? m_nImplicitMTThreads
+                                : std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+  // the TopLoop workers already keep m_nThreads cores busy
+  const std::size_t poolSize = total > m_nThreads ? total - m_nThreads : 0;
+  if (poolSize < 2) {
+    logger()->warn("{} threads for {} workers leave no room for implicit MT, not enabled",
+                   total, m_nThreads);
+    return;
+  }
+  ROOT::EnableImplicitMT(poolSize);
+  logger()->info("Implicit MT enabled with {} threads", poolSize);
+#else
+  logger()->warn("ROOT was built without implicit MT support, not enabled");
+#endif
+}
+
+void TL::Job::configureParallelUnzip(const TL::FileManager* fm) const {
+  if (not m_implicitMT || not ROOT::IsImplicitMTEnabled()) {
+    return;
+  }
+  for (const auto c : loopChains(m_loopType)) {
+    TChain* chain = fm->chain(c);
+    // parallel unzipping needs a cache, unless it was disabled on purpose
+    if (chain == nullptr || fm->cachePolicy(c).size == 0) {
+      continue;
+    }
+    // the cache type is chosen when the cache is created, a cache
+    // created by the first reads is replaced by a parallel one of the
+    // same size (before applyCachePolicies configures it)
+    const Long64_t cacheSize = chain->GetCacheSize();
+    chain->SetParallelUnzip(true);
+    chain->SetCacheSize(0);
+    chain->SetCacheSize(cacheSize > 0 ? cacheSize : 30000000);
+    logger()->debug("Parallel unzipping enabled for chain {}", chain->GetName());
+  }
+}
+
+void TL::Job::setEntryRange(uint64_t first, uint64_t last) {
+  m_rangeFirst = first;
+  m_rangeLast = std::max(first, last);
+}
+
+TL::StatusCode TL::Job::setShard(std::size_t i, std::size_t n) {
+  if (n == 0 || i >= n) {
+    logger()->error("Bad shard {} of {}", i, n);
+    return TL::StatusCode::FAILURE;
+  }
+  m_shardIndex = i;
+  m_nShards = n;
+  return TL::StatusCode::SUCCESS;
+}
+
+std::pair<uint64_t, uint64_t> TL::Job::loopEntryRange(
+    TChain* chain, TL::ClusterPartitioner& partitioner) const {
+  if (chain == nullptr) {
+    logger()->error("The chain driving the loop is null (is particle level enabled?)");
+    return {0, 0};
+  }
+  const uint64_t nEntries = chain->GetEntries();
+  uint64_t first = std::min(m_rangeFirst, nEntries);
+  uint64_t last = std::min(m_rangeLast, nEntries);
+  if (m_nShards > 1) {
+    // shards are cluster aligned so that no basket is read by two shards
+    if (partitioner.nClusters() == 0 && partitioner.scan(chain).isFailure()) {
+      logger()->warn("Cannot scan the chain clusters; shards split by entries");
+    }
+    auto units = partitioner.partition(m_nShards, first, last);
+    partitioner.report(units);
+    if (m_shardIndex < units.size()) {
+      first = units[m_shardIndex].first;
+      last = units[m_shardIndex].last;
+    }
+    else {
+      first = last;
+    }
+  }
+  if (first != 0 || last != nEntries) {
+    logger()->info("Processing entries [{}, {}) of {} (shard {} of {})", first, last,
+                   nEntries, m_shardIndex, m_nShards);
+  }
+  return {first, last};
+}
+
+void TL::Job::applyEntryRangeToIndices(uint64_t first, uint64_t last) {
+  auto outOfRange = [first, last](uint64_t entry) {
+    return entry < first || entry >= last;
+  };
+  if (m_loopType == TL::LoopType::RecoWithParticle) {
+    m_particleAndReco.erase(
+        std::remove_if(std::begin(m_particleAndReco), std::end(m_particleAndReco),
+                       [&outOfRange](const auto& idx) { return outOfRange(idx.second); }),
+        std::end(m_particleAndReco));
+  }
+  else if (m_loopType == TL::LoopType::ParticleOnly) {
+    m_particleLevelOnly.erase(std::remove_if(std::begin(m_particleLevelOnly),
+                                             std::end(m_particleLevelOnly), outOfRange),
+                              std::end(m_particleLevelOnly));
+  }
+  else if (m_loopType == TL::LoopType::RecoOnly) {
+    m_recoLevelOnly.erase(
+        std::remove_if(std::begin(m_recoLevelOnly), std::end(m_recoLevelOnly), outOfRange),
+        std::end(m_recoLevelOnly));
+  }
+}
+
 void TL::Job::setLoopType(const TL::LoopType loopType) { m_loopType = loopType; }
 
+void TL::Job::setIndexOrder(const TL::IndexOrder indexOrder) { m_indexOrder = indexOrder; }
+
+void TL::Job::enableLazyParticleLevel() { m_lazyParticleLevel = true; }
+
+void TL::Job::enableBranchAutoPrune(uint64_t nEvents) { m_autoPruneEvents = nEvents; }
+
+void TL::Job::setParticleLevelEntry(uint64_t entry) const {
+  // the lazy entries are shared with the co-algorithms
+  if (m_lazyParticleLevel) {
+    m_algorithm->m_lazyParticleLevel->set(m_algorithm->particleLevelReader().get(), entry);
+    m_algorithm->m_lazyTruth->set(m_algorithm->truthReader().get(), entry);
+  }
+  else {
+    m_algorithm->particleLevelReader()->SetEntry(entry);
+    m_algorithm->truthReader()->SetEntry(entry);
+  }
+}
+
+TL::StatusCode TL::Job::orderParticleAndReco() {
+  if (m_indexOrder == TL::IndexOrder::ParticleLevel) {
+    logger()->info("Processing the matched events in particle level order");
+    return TL::StatusCode::SUCCESS;
+  }
+  auto start = std::chrono::steady_clock::now();
+  if (m_indexOrder == TL::IndexOrder::RecoLevel) {
+    std::sort(std::begin(m_particleAndReco), std::end(m_particleAndReco),
+              [](const auto& a, const auto& b) {
+                return std::tie(a.second, a.first) < std::tie(b.second, b.first);
+              });
+  }
+  else {
+    TL::ClusterPartitioner recoClusters;
+    TL::ClusterPartitioner particleLevelClusters;
+    TL_CHECK(recoClusters.scan(m_fm->mainChain()));
+    TL_CHECK(particleLevelClusters.scan(m_fm->particleLevelChain()));
+    // (reco cluster, particle level cluster, reco entry, particle level entry)
+    std::vector<std::tuple<std::size_t, std::size_t, uint64_t, uint64_t>> keys;
+    keys.reserve(m_particleAndReco.size());
+    for (const auto& idx : m_particleAndReco) {
+      keys.emplace_back(recoClusters.clusterIndex(idx.second),
+                        particleLevelClusters.clusterIndex(idx.first), idx.second,
+                        idx.first);
+    }
+    std::sort(std::begin(keys), std::end(keys));
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+      m_particleAndReco[i] = {std::get<3>(keys[i]), std::get<2>(keys[i])};
+    }
+  }
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  logger()->info("Ordered {} matched events by {} ({:.2f} s)", m_particleAndReco.size(),
+                 m_indexOrder == TL::IndexOrder::RecoLevel ? "reco entry" : "cluster",
+                 elapsed.count());
+  return TL::StatusCode::SUCCESS;
+}
+
 TL::StatusCode TL::Job::constructIndices() {
   logger()->info("Constructing particle level and reco level indices");
   if (not m_particleLevelOnly.empty() || not m_particleAndReco.empty() ||
@@ -167,102 +1089,98 @@ TL::StatusCode TL::Job::constructIndices() {
     logger()->error(
         "Particle level chain is null... "
         "Enable particle level in your TL::FileManager!");
+    return TL::StatusCode::FAILURE;
   }
 
-  // make copies for this isolated task
-  auto chain_partLevel =
-      std::unique_ptr<TChain>(dynamic_cast<TChain*>(m_fm->particleLevelChain()->Clone()));
-  auto chain_recoLevel =
-      std::unique_ptr<TChain>(dynamic_cast<TChain*>(m_fm->mainChain()->Clone()));
-
-  chain_partLevel->SetBranchStatus("*", 0);
-  chain_recoLevel->SetBranchStatus("*", 0);
-  chain_partLevel->SetBranchStatus("runNumber", 1);
-  chain_recoLevel->SetBranchStatus("runNumber", 1);
-  chain_partLevel->SetBranchStatus("eventNumber", 1);
-  chain_recoLevel->SetBranchStatus("eventNumber", 1);
-  chain_partLevel->SetCacheSize(25000000);  // 25 MB cache
-  chain_recoLevel->SetCacheSize(25000000);  // 25 MB cache
-  chain_partLevel->AddBranchToCache("*", false);
-  chain_recoLevel->AddBranchToCache("*", false);
-  chain_partLevel->AddBranchToCache("runNumber", true);
-  chain_recoLevel->AddBranchToCache("runNumber", true);
-  chain_partLevel->AddBranchToCache("eventNumber", true);
-  chain_recoLevel->AddBranchToCache("eventNumber", true);
-
-  auto idx_PL =
-      std::make_unique<TTreeIndex>(chain_partLevel.get(), "runNumber", "eventNumber");
-  auto idx_RL =
-      std::make_unique<TTreeIndex>(chain_recoLevel.get(), "runNumber", "eventNumber");
-  chain_partLevel->SetTreeIndex(idx_PL.get());
-  chain_recoLevel->SetTreeIndex(idx_RL.get());
-
-  UInt_t runNumber_partLevel;
-  UInt_t runNumber_recoLevel;
-  ULong64_t eventNumber_partLevel;
-  ULong64_t eventNumber_recoLevel;
-
-  chain_partLevel->SetBranchAddress("runNumber", &runNumber_partLevel);
-  chain_recoLevel->SetBranchAddress("runNumber", &runNumber_recoLevel);
-  chain_partLevel->SetBranchAddress("eventNumber", &eventNumber_partLevel);
-  chain_recoLevel->SetBranchAddress("eventNumber", &eventNumber_recoLevel);
-
-  // do some conservative reserving to save time spent allocating
-  // memory... it shouldn't waste too much memory...
-  if (m_loopType == TL::LoopType::RecoWithParticle) {
-    m_particleAndReco.reserve(chain_recoLevel->GetEntries());
-  }
-  if (m_loopType == TL::LoopType::ParticleOnly) {
-    m_particleLevelOnly.reserve(chain_partLevel->GetEntries());
-  }
-  if (m_loopType == TL::LoopType::RecoOnly) {
-    m_recoLevelOnly.reserve(chain_recoLevel->GetEntries());
-  }
-
-  ULong64_t totalPartLevel = static_cast<ULong64_t>(chain_partLevel->GetEntries());
-  ULong64_t totalRecoLevel = static_cast<ULong64_t>(chain_recoLevel->GetEntries());
-
-  if (m_loopType == TL::LoopType::RecoWithParticle ||
-      m_loopType == TL::LoopType::ParticleOnly) {
-    tqdm index_bar;
-    index_bar.set_theme_braille_spin();
-    // get indices for particle+reco and particle only
-    for (ULong64_t i = 0; i < totalPartLevel; ++i) {
-      chain_partLevel->GetEntry(i);
-      auto index_RL = chain_recoLevel->GetEntryNumberWithIndex(runNumber_partLevel,
-                                                               eventNumber_partLevel);
-      if (index_RL > 0) {
-        if (m_loopType == TL::LoopType::RecoWithParticle) {
-          m_particleAndReco.push_back(std::make_pair(i, index_RL));
-        }
-      }
-      else {
-        if (m_loopType == TL::LoopType::ParticleOnly) {
-          m_particleLevelOnly.push_back(i);
-        }
-      }
-      index_bar.progress(i, totalPartLevel);
+  // the join only depends on the input files, a previous job on the
+  // same sample may have saved it
+  std::unique_ptr<TL::IndexCache> indexCache{nullptr};
+  if (not m_indexCacheDir.empty()) {
+    auto start = std::chrono::steady_clock::now();
+    indexCache = std::make_unique<TL::IndexCache>(m_indexCacheDir, m_fm->fileNames(),
+                                                  m_fm->treeName(),
+                                                  m_fm->particleLevelTreeName());
+    if (indexCache->load(m_particleAndReco, m_particleLevelOnly, m_recoLevelOnly)) {
+      std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+      logger()->info("Loaded the indices from {} ({:.1f} ms)", indexCache->path(),
+                     1000 * elapsed.count());
+      keepLoopIndices();
+      return TL::StatusCode::SUCCESS;
     }
   }
 
-  if (m_loopType == TL::LoopType::RecoOnly) {
-    // get indices for reco only
-    for (ULong64_t i = 0; i < totalRecoLevel; ++i) {
-      chain_recoLevel->GetEntry(i);
-      auto index_CL = chain_recoLevel->GetEntryNumberWithIndex(runNumber_recoLevel,
-                                                               eventNumber_recoLevel);
-      if (index_CL < 0) {
-        m_recoLevelOnly.push_back(i);
-      }
+  // a cached join holds all of the index vectors, so that it can be
+  // used by any loop type
+  const bool all = indexCache != nullptr;
+  const bool withParticle = all || m_loopType == TL::LoopType::RecoWithParticle;
+  const bool particleOnly = all || m_loopType == TL::LoopType::ParticleOnly;
+  const bool recoOnly = all || m_loopType == TL::LoopType::RecoOnly;
+
+  // read the (runNumber, eventNumber) columns once and match them in
+  // bulk, instead of one TTreeIndex lookup per entry
+  TL::EventIndexJoin indexJoin;
+  if (TL::EventIndexJoin::canJoinPerFile(m_fm->particleLevelChain(), m_fm->mainChain())) {
+    const std::size_t nThreads =
+        m_nIndexThreads > 0 ? m_nIndexThreads : std::thread::hardware_concurrency();
+    TL_CHECK(indexJoin.joinPerFile(m_fm->particleLevelChain(), m_fm->mainChain(), nThreads,
+                                   withParticle ? &m_particleAndReco : nullptr,
+                                   particleOnly ? &m_particleLevelOnly : nullptr,
+                                   recoOnly ? &m_recoLevelOnly : nullptr));
+  }
+  else {
+    TL::EventKeys keys_partLevel;
+    TL::EventKeys keys_recoLevel;
+    auto start = std::chrono::steady_clock::now();
+    TL_CHECK(indexJoin.readKeys(m_fm->particleLevelChain(), keys_partLevel));
+    TL_CHECK(indexJoin.readKeys(m_fm->mainChain(), keys_recoLevel));
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    logger()->info("Read the event keys of {} particle level and {} reco entries ({:.2f} s)",
+                   keys_partLevel.size(), keys_recoLevel.size(), elapsed.count());
+
+    // do some conservative reserving to save time spent allocating
+    // memory... it shouldn't waste too much memory...
+    if (withParticle) {
+      m_particleAndReco.reserve(keys_recoLevel.size());
+    }
+    if (particleOnly) {
+      m_particleLevelOnly.reserve(keys_partLevel.size());
     }
+    if (recoOnly) {
+      m_recoLevelOnly.reserve(keys_recoLevel.size());
+    }
+
+    indexJoin.join(keys_partLevel, keys_recoLevel,
+                   withParticle ? &m_particleAndReco : nullptr,
+                   particleOnly ? &m_particleLevelOnly : nullptr,
+                   recoOnly ? &m_recoLevelOnly : nullptr);
   }
 
-  chain_partLevel->SetBranchStatus("*", 1);
-  chain_recoLevel->SetBranchStatus("*", 1);
+  if (indexCache != nullptr) {
+    // not being able to write the cache is not fatal for this job
+    if (indexCache->save(m_particleAndReco, m_particleLevelOnly, m_recoLevelOnly)
+            .isFailure()) {
+      logger()->warn("The indices will be computed again by the next job");
+    }
+    keepLoopIndices();
+  }
 
   return TL::StatusCode::SUCCESS;
 }
 
+void TL::Job::keepLoopIndices() {
+  if (m_loopType != TL::LoopType::RecoWithParticle) {
+    std::vector<std::pair<uint64_t, uint64_t>>().swap(m_particleAndReco);
+  }
+  if (m_loopType != TL::LoopType::ParticleOnly) {
+    std::vector<uint64_t>().swap(m_particleLevelOnly);
+  }
+  if (m_loopType != TL::LoopType::RecoOnly) {
+    std::vector<uint64_t>().swap(m_recoLevelOnly);
+  }
+}
+
+void TL::Job::enableIndexCache(const std::string& directory) { m_indexCacheDir = directory; }
+
 void TL::Job::printProgress(int n_prints, long total_entries, long event_count) const {
   if (total_entries > n_prints) {
     int gap = total_entries / n_prints;
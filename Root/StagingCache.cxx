@@ -0,0 +1,318 @@
+/*! @file StagingCache.cxx
+ *  @brief TL::StagingCache class implementation
+ */
+
+// TL
+#include <TopLoop/Core/FilePrefetcher.h>
+#include <TopLoop/Core/StagingCache.h>
+
+// Boost
+#include <boost/algorithm/string/predicate.hpp>
+#include <boost/filesystem/operations.hpp>
+#include <boost/filesystem/path.hpp>
+#include <boost/version.hpp>
+namespace fs = boost::filesystem;
+
+// C++
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <ctime>
+#include <fstream>
+#include <functional>
+#include <utility>
+#include <vector>
+
+// POSIX
+#include <fcntl.h>
+#include <sys/file.h>
+#include <unistd.h>
+
+namespace {
+
+/// prefix of the local copies, only these are ever removed
+const std::string stagedPrefix = "TL_stage_";
+/// prefix of the lists of the copies pinned by each job
+const std::string pinsPrefix = "TL_pins_";
+/// lock file serializing pinning and removing copies across jobs
+const std::string lockName = "TL_stage.lock";
+
+/// holds an exclusive lock on a file for its lifetime
+class FileLock {
+ private:
+  int m_fd;
+
+ public:
+  explicit FileLock(const std::string& path)
+      : m_fd(::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0666)) {
+    if (m_fd >= 0 && ::flock(m_fd, LOCK_EX) != 0) {
+      ::close(m_fd);
+      m_fd = -1;
+    }
+  }
+  ~FileLock() {
+    if (m_fd >= 0) {
+      ::close(m_fd);
+    }
+  }
+  FileLock(const FileLock&) = delete;
+  FileLock& operator=(const FileLock&) = delete;
+  bool locked() const { return m_fd >= 0; }
+};
+
+}  // namespace
+
+TL::StagingCache::StagingCache(const std::string& directory, uint64_t maxBytes)
+    : TL::Loggable("TL::StagingCache"), m_directory(directory), m_maxBytes(maxBytes) {
+  boost::system::error_code ec;
+  fs::create_directories(m_directory, ec);
+  if (ec) {
+    logger()->warn("Cannot create the staging directory {}: {}", m_directory, ec.message());
+  }
+  // the pins file stays locked while this job runs
+  m_pinsPath = (fs::path(m_directory) /
+                fmt::format("{}{}_{:x}", pinsPrefix, ::getpid(),
+                            reinterpret_cast<std::uintptr_t>(this)))
+                   .string();
+  m_pinsFd = ::open(m_pinsPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_APPEND | O_CLOEXEC,
+                    0666);
+  if (m_pinsFd >= 0 && ::flock(m_pinsFd, LOCK_EX | LOCK_NB) != 0) {
+    ::close(m_pinsFd);
+    m_pinsFd = -1;
+  }
+  if (m_pinsFd < 0) {
+    logger()->warn("Cannot pin copies in {}, local copies will not be used", m_directory);
+  }
+  m_worker = std::thread(&TL::StagingCache::work, this);
+}
+
+TL::StagingCache::~StagingCache() {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stop = true;
+  }
+  m_wakeUp.notify_all();
+  if (m_worker.joinable()) {
+    m_worker.join();
+  }
+  if (m_pinsFd >= 0) {
+    boost::system::error_code ec;
+    fs::remove(m_pinsPath, ec);
+    ::close(m_pinsFd);
+  }
+}
+
+std::string TL::StagingCache::localPath(const std::string& source) const {
+  // the hash of the full path keeps files with the same name apart,
+  // the modification time keeps copies of older versions apart
+  boost::system::error_code ec;
+  const auto mtime = fs::last_write_time(source, ec);
+  const auto hash = std::hash<std::string>{}(fmt::format("{}:{}", source, ec ? 0 : mtime));
+  const auto name = fmt::format("{}{:016x}_{}", stagedPrefix, hash,
+                                fs::path(source).filename().string());
+  return (fs::path(m_directory) / name).string();
+}
+
+bool TL::StagingCache::isStaged(const std::string& source) const {
+  boost::system::error_code ec;
+  const auto localSize = fs::file_size(localPath(source), ec);
+  if (ec) {
+    return false;
+  }
+  // only complete copies are renamed to the local path
+  const auto sourceSize = fs::file_size(source, ec);
+  return not ec && sourceSize == localSize;
+}
+
+std::string TL::StagingCache::resolve(const std::string& source) {
+  if (m_pinsFd < 0 || not isStaged(source)) {
+    return source;
+  }
+  const auto local = localPath(source);
+  FileLock lock((fs::path(m_directory) / lockName).string());
+  // another job may have removed the copy before the lock was taken
+  if (not lock.locked() || not isStaged(source)) {
+    return source;
+  }
+  {
+    // pins are file names, jobs may spell the directory differently
+    const auto name = fs::path(local).filename().string();
+    std::lock_guard<std::mutex> guard(m_mutex);
+    if (m_pinned.count(name) == 0) {
+      const auto line = name + "\n";
+      const auto n = ::write(m_pinsFd, line.c_str(), line.size());
+      if (n != static_cast<ssize_t>(line.size())) {
+        logger()->warn("Cannot pin {}, reading {} instead", local, source);
+        return source;
+      }
+      m_pinned.insert(name);
+    }
+    m_nHits++;
+  }
+  boost::system::error_code ec;
+  fs::last_write_time(local, std::time(nullptr), ec);
+  return local;
+}
+
+void TL::StagingCache::stage(const std::string& source) {
+  if (not TL::FilePrefetcher::isLocal(source) ||
+      boost::algorithm::starts_with(source, m_directory)) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (not m_requested.insert(source).second) {
+      return;
+    }
+    m_queue.push_back(source);
+  }
+  m_wakeUp.notify_one();
+}
+
+void TL::StagingCache::work() {
+  while (true) {
+    std::string source;
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_wakeUp.wait(lock, [this] { return m_stop || not m_queue.empty(); });
+      if (m_stop) {
+        return;
+      }
+      source = std::move(m_queue.front());
+      m_queue.pop_front();
+    }
+    if (isStaged(source)) {
+      continue;
+    }
+    const bool ok = copy(source);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (ok) {
+      m_nStaged++;
+    }
+    else {
+      m_nFailed++;
+    }
+  }
+}
+
+bool TL::StagingCache::copy(const std::string& source) {
+  boost::system::error_code ec;
+  const auto size = fs::file_size(source, ec);
+  if (ec) {
+    logger()->warn("Cannot stage {}: {}", source, ec.message());
+    return false;
+  }
+  if (not makeRoom(size)) {
+    logger()->warn("Not enough room in {} to stage {}", m_directory, source);
+    return false;
+  }
+  const auto local = localPath(source);
+  const auto tmp = fmt::format("{}.part{}", local, ::getpid());
+#if BOOST_VERSION >= 107400
+  fs::copy_file(source, tmp, fs::copy_options::overwrite_existing, ec);
+#else
+  fs::copy_file(source, tmp, fs::copy_option::overwrite_if_exists, ec);
+#endif
+  // the data must be on disk before the copy gets its final name,
+  // otherwise a crash could leave a truncated file under that name
+  if (not ec) {
+    const int fd = ::open(tmp.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0 || ::fsync(fd) != 0) {
+      ec = boost::system::error_code(errno, boost::system::generic_category());
+    }
+    if (fd >= 0) {
+      ::close(fd);
+    }
+  }
+  if (not ec) {
+    fs::rename(tmp, local, ec);
+  }
+  if (ec) {
+    logger()->warn("Staging {} failed: {}", source, ec.message());
+    fs::remove(tmp, ec);
+    return false;
+  }
+  logger()->debug("Staged {} ({:.1f} MB)", source, size / 1.0e6);
+  return true;
+}
+
+std::set<std::string> TL::StagingCache::pinnedByOthers() const {
+  std::set<std::string> pinned;
+  boost::system::error_code ec;
+  for (const auto& entry : fs::directory_iterator(m_directory, ec)) {
+    const auto path = entry.path().string();
+    if (path == m_pinsPath ||
+        not boost::algorithm::starts_with(entry.path().filename().string(), pinsPrefix)) {
+      continue;
+    }
+    // a pins file nobody holds a lock on belongs to a job which died
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+      continue;
+    }
+    if (::flock(fd, LOCK_EX | LOCK_NB) == 0) {
+      fs::remove(entry.path(), ec);
+      ::close(fd);
+      continue;
+    }
+    ::close(fd);
+    std::ifstream pins(path);
+    std::string line;
+    while (std::getline(pins, line)) {
+      pinned.insert(line);
+    }
+  }
+  return pinned;
+}
+
+bool TL::StagingCache::makeRoom(uint64_t bytes) {
+  if (bytes > m_maxBytes) {
+    return false;
+  }
+  FileLock lock((fs::path(m_directory) / lockName).string());
+  if (not lock.locked()) {
+    return false;
+  }
+  std::set<std::string> pinned = pinnedByOthers();
+  {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    pinned.insert(std::begin(m_pinned), std::end(m_pinned));
+  }
+  // the copies in the directory, least recently used first
+  std::vector<std::pair<std::time_t, fs::path>> copies;
+  uint64_t used = 0;
+  boost::system::error_code ec;
+  for (const auto& entry : fs::directory_iterator(m_directory, ec)) {
+    const auto name = entry.path().filename().string();
+    if (not boost::algorithm::starts_with(name, stagedPrefix)) {
+      continue;
+    }
+    // partial copies (of other jobs too) count against the cap
+    used += fs::file_size(entry.path(), ec);
+    if (name.find(".part") == std::string::npos) {
+      copies.emplace_back(fs::last_write_time(entry.path(), ec), entry.path());
+    }
+  }
+  std::sort(std::begin(copies), std::end(copies));
+
+  for (const auto& copy : copies) {
+    if (used + bytes <= m_maxBytes) {
+      break;
+    }
+    if (pinned.count(copy.second.filename().string()) > 0) {
+      continue;
+    }
+    const auto size = fs::file_size(copy.second, ec);
+    if (fs::remove(copy.second, ec)) {
+      used -= std::min(used, size);
+      logger()->debug("Removed {} from the staging directory", copy.second.string());
+    }
+  }
+  return used + bytes <= m_maxBytes;
+}
+
+void TL::StagingCache::report() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  logger()->info("{} files read from the staging directory {}, {} staged, {} failed",
+                 m_nHits, m_directory, m_nStaged, m_nFailed);
+}
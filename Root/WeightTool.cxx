@@ -13,6 +13,9 @@
 #include <PathResolver/PathResolver.h>
 #include <TopDataPreparation/SampleXsectionSvc.h>
 
+// ROOT
+#include <TChain.h>
+
 // C++
 #include <cmath>
 
@@ -220,6 +223,132 @@ float TL::WeightTool::currentWeightOfVariation(const std::size_t idx) {
   return m_alg->mc_generator_weights()[idx];
 }
 
+std::function<float()> TL::WeightTool::weightVariationScalar(const std::string& branch) {
+  if (not m_alg->hasBranch(m_alg->reader()->GetTree(), branch.c_str())) {
+    logger()->error("Cannot find weight branch {}", branch);
+    return {};
+  }
+  // the algorithm's accessor, the branch is not read twice
+  auto accessor = m_alg->m_floatAccessors.find(branch);
+  if (accessor != std::end(m_alg->m_floatAccessors)) {
+    const TL::Algorithm* alg = m_alg;
+    const auto get = accessor->second;
+    return [alg, get] { return (alg->*get)(); };
+  }
+  auto itr = m_wvScalarBranches.find(branch);
+  if (itr == std::end(m_wvScalarBranches)) {
+    itr = m_wvScalarBranches
+              .emplace(branch, m_alg->setupBranch<TTreeReaderValue<float>>(m_alg->reader(),
+                                                                           branch.c_str()))
+              .first;
+  }
+  TTreeReaderValue<float>* value = itr->second.get();
+  return [value] { return **value; };
+}
+
+std::function<const std::vector<float>&()> TL::WeightTool::weightVariationVector(
+    const std::string& branch) {
+  if (not m_alg->hasBranch(m_alg->reader()->GetTree(), branch.c_str())) {
+    logger()->error("Cannot find weight branch {}", branch);
+    return {};
+  }
+  auto accessor = m_alg->m_floatVectorAccessors.find(branch);
+  if (accessor != std::end(m_alg->m_floatVectorAccessors)) {
+    const TL::Algorithm* alg = m_alg;
+    const auto get = accessor->second;
+    return [alg, get]() -> const std::vector<float>& { return (alg->*get)(); };
+  }
+  auto itr = m_wvVectorBranches.find(branch);
+  if (itr == std::end(m_wvVectorBranches)) {
+    itr = m_wvVectorBranches
+              .emplace(branch, m_alg->setupBranch<TTreeReaderValue<std::vector<float>>>(
+                                   m_alg->reader(), branch.c_str()))
+              .first;
+  }
+  TTreeReaderValue<std::vector<float>>* value = itr->second.get();
+  return [value]() -> const std::vector<float>& { return **value; };
+}
+
+TL::StatusCode TL::WeightTool::addWeightVariation(const std::string& branch,
+                                                  const std::string& nominal) {
+  auto nominalValue = weightVariationScalar(nominal);
+  auto variedValue = weightVariationScalar(branch);
+  if (not nominalValue || not variedValue) {
+    return TL::StatusCode::FAILURE;
+  }
+  m_weightVariations.push_back({branch, branch, nominalValue, variedValue, {}, 0, 0});
+  m_weightVariationNames.push_back(branch);
+  return TL::StatusCode::SUCCESS;
+}
+
+TL::StatusCode TL::WeightTool::addWeightVariationVector(const std::string& branch,
+                                                        const std::string& nominal) {
+  auto nominalValue = weightVariationScalar(nominal);
+  auto variedValue = weightVariationVector(branch);
+  if (not nominalValue || not variedValue) {
+    return TL::StatusCode::FAILURE;
+  }
+  // the number of variations is only known from an entry; read it
+  // from a copy of the chain, the algorithm's readers are shared
+  // with other algorithms and must not be moved. The vector can be
+  // empty in some events (and the first files can have no entries),
+  // the first entry where it is not empty is used.
+  auto chain = std::unique_ptr<TChain>(
+      dynamic_cast<TChain*>(m_alg->fileManager()->mainChain()->Clone()));
+  chain->SetBranchStatus("*", 0);
+  chain->SetBranchStatus(branch.c_str(), 1);
+  std::vector<float>* values = nullptr;
+  chain->SetBranchAddress(branch.c_str(), &values);
+  std::size_t n = 0;
+  const Long64_t nEntries = chain->GetEntries();
+  for (Long64_t entry = 0; entry < nEntries && n == 0; ++entry) {
+    if (chain->GetEntry(entry) <= 0 || values == nullptr) {
+      break;
+    }
+    n = values->size();
+  }
+  chain->ResetBranchAddresses();
+  std::unique_ptr<std::vector<float>> ownedValues(values);
+  if (n == 0) {
+    logger()->warn("No entry where {} is not empty, no variations added", branch);
+    return TL::StatusCode::SUCCESS;
+  }
+  for (std::size_t i = 0; i < n; ++i) {
+    auto name = fmt::format("{}_{}", branch, i);
+    m_weightVariations.push_back({name, branch, nominalValue, {}, variedValue, i, n});
+    m_weightVariationNames.push_back(name);
+  }
+  logger()->debug("Added {} weight variations from {}", n, branch);
+  return TL::StatusCode::SUCCESS;
+}
+
+TL::StatusCode TL::WeightTool::weightVariationFactors(std::vector<float>& factors) const {
+  factors.resize(m_weightVariations.size());
+  for (std::size_t i = 0; i < m_weightVariations.size(); ++i) {
+    const auto& var = m_weightVariations[i];
+    const float nominal = var.nominal();
+    float varied = 0;
+    if (var.scalar) {
+      varied = var.scalar();
+    }
+    else {
+      const auto& values = var.vector();
+      if (values.size() != var.size && m_wvSizeWarnings.insert(var.branch).second) {
+        logger()->warn(
+            "{} holds {} variations in this event, {} were declared; missing ones are zero",
+            var.branch, values.size(), var.size);
+      }
+      if (var.index >= values.size()) {
+        factors[i] = 0;
+        continue;
+      }
+      varied = values[var.index];
+    }
+    factors[i] = nominal != 0 ? varied / nominal : 0;
+  }
+  return TL::StatusCode::SUCCESS;
+}
+
 float TL::WeightTool::sampleCrossSection() const {
   auto dsid = m_alg->fileManager()->dsid();
   auto xsec = m_xsec->getXsection(dsid);
@@ -15,6 +15,7 @@
 #define TL_Algorithm_h
 
 // TL
+#include <TopLoop/Core/EventBatch.h>
 #include <TopLoop/Core/FileManager.h>
 #include <TopLoop/Core/Loggable.h>
 #include <TopLoop/Core/Utils.h>
@@ -23,6 +24,7 @@
 
 // ROOT
 #include <TChain.h>
+#include <TList.h>
 
 namespace TL {
 namespace EDM {
@@ -35,6 +37,7 @@ namespace TL {
 class Algorithm : public TL::Loggable, public TL::Variables {
  private:
   std::string m_datasetName{""};
+  std::string m_currentTreeName{"nominal"};
   bool m_isMC{true};
   bool m_isFake{false};
   bool m_isNominalTree{true};
@@ -42,18 +45,21 @@ class Algorithm : public TL::Loggable, public TL::Variables {
   bool m_initCalled{false};
   bool m_isRel207{false};
   bool m_truthAvailable{false};
+  std::size_t m_workerIndex{0};
 
   std::size_t m_totalEntries{0};
   std::size_t m_eventCounter{0};
   std::size_t m_totalParticleLevelEntries{0};
 
-  std::unique_ptr<TL::FileManager> m_fm{nullptr};
+  std::shared_ptr<TL::FileManager> m_fm{nullptr};
+  std::vector<std::string> m_unusedBranches{};
   std::shared_ptr<TTreeReader> m_reader{nullptr};
   std::shared_ptr<TTreeReader> m_weightsReader{nullptr};
   std::shared_ptr<TTreeReader> m_particleLevelReader{nullptr};
   std::shared_ptr<TTreeReader> m_truthReader{nullptr};
 
   TL::WeightTool m_weightTool{this};
+  TL::EventBatch m_eventBatch{};
 
  public:
   /// default constructor
@@ -80,7 +86,19 @@ class Algorithm : public TL::Loggable, public TL::Variables {
    *  This is a requirement of all TopLoop algorithms Must be called
    *  before feeding to the TL::Job object.
    */
-  TL::StatusCode setFileManager(std::unique_ptr<TL::FileManager> fm);
+  TL::StatusCode setFileManager(std::shared_ptr<TL::FileManager> fm);
+
+  /// share the FileManager and TTreeReaders of another algorithm
+  /*!
+   *  Used by TL::Job to run several algorithms over one read of the
+   *  data. Must be called before init(), which then connects the
+   *  branches of this algorithm to the shared readers instead of
+   *  creating new ones.
+   */
+  TL::StatusCode shareInput(const TL::Algorithm& primary);
+
+  /// Set the name of the tree the upcoming events belong to
+  void setCurrentTree(const std::string& treeName);
 
   /// uses the FileManager and SampleMetaSvc to check the release
   void checkRelease();
@@ -123,6 +141,18 @@ class Algorithm : public TL::Loggable, public TL::Variables {
    */
   virtual TL::StatusCode execute();
 
+  /// The function which is called for each window of entries in batch mode
+  /*!
+   *  Only used if the TL::Job is given a batch size (see
+   *  TL::Job::setBatchSize), in which case it is called instead of
+   *  execute(). The batch holds the columns declared with
+   *  addBatchColumn() and addBatchJaggedColumn() for a window of
+   *  consecutive entries. A user implementation must call
+   *  TL::Algorithm::executeBatch(batch) (to keep the event counter
+   *  up to date).
+   */
+  virtual TL::StatusCode executeBatch(const TL::EventBatch& batch);
+
   /// The function which is called at the end.
   /*!
    *  This function is meant to wrap up the algorithm, e.g.  write
@@ -130,6 +160,41 @@ class Algorithm : public TL::Loggable, public TL::Variables {
    */
   virtual TL::StatusCode finish();
 
+  /// Fold the results of a worker replica into this algorithm.
+  /*!
+   *  Only used when the TL::Job is running on multiple threads. At
+   *  the end of the event loop this function is called on the
+   *  primary algorithm (workerIndex() == 0) once per replica, before
+   *  finish() is called on the primary algorithm alone. A user
+   *  implementation should merge its histograms, counters, etc. from
+   *  the replica (which has to be cast to the user's class), and
+   *  must call TL::Algorithm::merge(replica).
+   */
+  virtual TL::StatusCode merge(const TL::Algorithm& replica);
+
+  /// Save the state needed to resume the job from a checkpoint.
+  /*!
+   *  Only used if the TL::Job has checkpointing enabled (see
+   *  TL::Job::enableCheckpointing). It is called between two events,
+   *  on the event loop thread. A user implementation should add
+   *  _copies_ of the objects describing its progress (histograms,
+   *  counters stored as TParameter, ...) to the list, which owns
+   *  them. The copies are written to the checkpoint file in the
+   *  background. Histograms cloned here are not added to the
+   *  current directory (see TH1::AddDirectory).
+   */
+  virtual TL::StatusCode checkpointState(TList& state) const;
+
+  /// Restore the state saved by checkpointState().
+  /*!
+   *  Called after setupOutput() when the job resumes from a
+   *  checkpoint (see TL::Job::resumeFromCheckpoint). The list holds
+   *  the objects added in checkpointState() (with the same names)
+   *  and keeps ownership of them, so a user implementation should
+   *  copy or add them to its own objects.
+   */
+  virtual TL::StatusCode restoreState(const TList& state);
+
   /// @}
 
  private:
@@ -147,12 +212,30 @@ class Algorithm : public TL::Loggable, public TL::Variables {
   /// Function to tell algorithm its analyzing fakes
   void setIsFake() { m_isFake = true; }
 
+  /// Declare the branches of the main tree the algorithm never reads
+  /*!
+   *  TL::Job disables the branches which are unused by every
+   *  algorithm it runs (for a job with a single algorithm, this is
+   *  equivalent to TL::FileManager::disableBranches). If any
+   *  algorithm of the job does not declare its unused branches, no
+   *  branch is disabled by the job.
+   */
+  void setUnusedBranches(const std::vector<std::string>& branch_list) {
+    m_unusedBranches = branch_list;
+  }
+
   /// @}
 
  protected:
   /// @name Sample property utilities
   /// @{
 
+  /// the name of the tree the current event belongs to
+  /*!
+   *  Only changes during the job if the FileManager was given
+   *  several tree names (see TL::FileManager::setTreeNames).
+   */
+  const std::string& currentTreeName() const { return m_currentTreeName; }
   /// true if the algorithm is processing the "nominal" tree
   bool isNominalTree() const { return m_isNominalTree; }
   /// true if the algoritm is processing the loose "nominal" tree
@@ -171,6 +254,8 @@ class Algorithm : public TL::Loggable, public TL::Variables {
   long eventCount() const { return m_eventCounter; }
   /// get if truth information is available
   bool truthAvailable() const { return m_truthAvailable; }
+  /// get the index of the worker thread running this instance (0 for the primary)
+  std::size_t workerIndex() const { return m_workerIndex; }
   /// @}
 
  protected:
@@ -182,6 +267,29 @@ class Algorithm : public TL::Loggable, public TL::Variables {
 
   /// @}
 
+ protected:
+  /// @name batch mode utilities
+  /*!
+   *  Declare the columns filled in the TL::EventBatch given to
+   *  executeBatch(). Must be called in init() (after
+   *  TL::Algorithm::init()) or setupOutput().
+   */
+  /// @{
+
+  /// add a column for a primitive branch of the main tree (e.g. weight_mc)
+  template <typename T>
+  TL::StatusCode addBatchColumn(const std::string& name) {
+    return m_eventBatch.addColumn<T>(m_reader, name, m_readerTreeChanges);
+  }
+
+  /// add a column for a std::vector<T> branch of the main tree (e.g. jet_pt)
+  template <typename T>
+  TL::StatusCode addBatchJaggedColumn(const std::string& name) {
+    return m_eventBatch.addJaggedColumn<T>(m_reader, name);
+  }
+
+  /// @}
+
  protected:
   /// @name Sample pointer getters
   /// @{
@@ -205,6 +313,11 @@ class Algorithm : public TL::Loggable, public TL::Variables {
 
  protected:
   /// Print the progess of the event loop (percent done)
+  /*!
+   *  When the job runs on multiple threads this only counts the
+   *  events processed by this worker; the job reports the overall
+   *  progress.
+   */
   void printProgress(const unsigned int n_prints = 10) const;
 
  public:
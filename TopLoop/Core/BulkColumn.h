@@ -0,0 +1,160 @@
+/*! @file  BulkColumn.h
+ *  @brief TL::BulkColumn class header
+ *  @class TL::BulkColumn
+ *  @brief Reads a primitive branch a basket at a time.
+ *
+ *  A TTreeReaderValue reads its branch one entry at a time. For a
+ *  branch holding one fixed size number per entry (e.g. weight_mc,
+ *  met_met, runNumber) ROOT's bulk API deserializes a whole basket
+ *  into a contiguous array in a single call. This class keeps that
+ *  array (one buffer per branch, i.e. structure of arrays) and
+ *  returns the value of the entry the reader is on by indexing into
+ *  it; the next basket is only read when the reader leaves the
+ *  current one. Used by the primitive accessors of TL::Variables
+ *  when bulk access is enabled (see
+ *  TL::Variables::enableBulkBranchAccess).
+ */
+
+#ifndef TL_BulkColumn_h
+#define TL_BulkColumn_h
+
+// TL
+#include <TopLoop/Core/Loggable.h>
+
+// ROOT
+#include <TBranch.h>
+#include <TBufferFile.h>
+#include <TDataType.h>
+#include <TLeaf.h>
+#include <TTree.h>
+#include <TTreeReader.h>
+
+// C++
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <typeinfo>
+
+namespace TL {
+
+template <typename T>
+class BulkColumn {
+ private:
+  TTreeReader* m_reader;
+  const std::size_t* m_treeChanges;
+  std::size_t m_seenTreeChanges{0};
+  std::string m_name;
+  TBranch* m_branch{nullptr};
+  TLeaf* m_leaf{nullptr};
+  Int_t m_treeNumber{-1};
+  bool m_bulk{true};
+  Long64_t m_first{0};
+  Long64_t m_count{0};
+  const T* m_values{nullptr};
+  TBufferFile m_buffer{TBuffer::kWrite, 10000};
+
+  /// connect to the branch of the tree the reader is on
+  void reset(TTree* tree) {
+    m_branch = tree->GetBranch(m_name.c_str());
+    m_leaf = m_branch == nullptr ? nullptr
+                                 : static_cast<TLeaf*>(m_branch->GetListOfLeaves()->At(0));
+    m_bulk = true;
+    m_count = 0;
+  }
+
+  /// read the basket holding an entry of the current tree
+  bool load(Long64_t entry) {
+    // the bulk API only reads from the first entry of a basket
+    const Long64_t* basketEntry = m_branch->GetBasketEntry();
+    const auto basket =
+        std::upper_bound(basketEntry, basketEntry + m_branch->GetWriteBasket(), entry);
+    if (basket == basketEntry) {
+      return false;
+    }
+    const Long64_t first = *(basket - 1);
+    const Int_t n = m_branch->GetBulkRead().GetBulkEntries(first, m_buffer);
+    if (n <= 0 || entry >= first + n) {
+      return false;
+    }
+    m_first = first;
+    m_count = n;
+    m_values = reinterpret_cast<const T*>(m_buffer.GetCurrent());
+    return true;
+  }
+
+ public:
+  /// connect to a branch of the tree of a reader
+  /*!
+   *  @p treeChanges is incremented by the owner whenever the reader
+   *  is given another tree (see TTreeReader::SetTree); a change of
+   *  tree within a chain is detected from its tree number.
+   */
+  BulkColumn(TTreeReader& reader, const char* name, const std::size_t& treeChanges)
+      : m_reader(&reader), m_treeChanges(&treeChanges), m_name(name) {}
+
+  /// check if a branch of the tree of a reader can be read in bulk as T
+  static bool supported(TTreeReader& reader, const char* name) {
+    TTree* tree = reader.GetTree() == nullptr ? nullptr : reader.GetTree()->GetTree();
+    if (tree == nullptr) {
+      return false;
+    }
+    TBranch* branch = tree->GetBranch(name);
+    if (branch == nullptr || not branch->GetBulkRead().SupportsBulkRead()) {
+      return false;
+    }
+    // one value per entry, stored as exactly T
+    auto leaf = static_cast<TLeaf*>(branch->GetListOfLeaves()->At(0));
+    return leaf != nullptr && leaf->GetLeafCount() == nullptr &&
+           leaf->GetLenStatic() == 1 &&
+           std::strcmp(leaf->GetTypeName(),
+                       TDataType::GetTypeName(TDataType::GetType(typeid(T)))) == 0;
+  }
+
+  /// read the value of the entry the reader is on
+  /*!
+   *  Returns false if the branch cannot be read from the current
+   *  tree. If a basket cannot be read in bulk the branch is read
+   *  entry by entry until the reader moves to another tree.
+   */
+  bool read(T& value) {
+    // the reader works on a chain, the branches belong to its trees
+    TTree* chain = m_reader->GetTree();
+    TTree* tree = chain->GetTree();
+    const Int_t treeNumber = chain->GetTreeNumber();
+    if (treeNumber != m_treeNumber || *m_treeChanges != m_seenTreeChanges) {
+      m_treeNumber = treeNumber;
+      m_seenTreeChanges = *m_treeChanges;
+      reset(tree);
+    }
+    if (m_branch == nullptr || m_leaf == nullptr) {
+      return false;
+    }
+    const Long64_t entry = tree->GetReadEntry();
+    if (entry >= m_first && entry < m_first + m_count) {
+      value = m_values[entry - m_first];
+      return true;
+    }
+    if (m_bulk && load(entry)) {
+      value = m_values[entry - m_first];
+      return true;
+    }
+    if (m_bulk) {
+      m_bulk = false;
+      m_count = 0;
+      spdlog::get("BranchAccess")
+          ->warn("Cannot bulk read {} at entry {} of tree {}, reading it entry by entry",
+                 m_name, entry, tree->GetName());
+    }
+    if (m_branch->GetEntry(entry) <= 0) {
+      spdlog::get("BranchAccess")
+          ->error("Cannot read {} at entry {} of tree {}", m_name, entry, tree->GetName());
+      return false;
+    }
+    value = *static_cast<const T*>(m_leaf->GetValuePointer());
+    return true;
+  }
+};
+
+}  // namespace TL
+
+#endif
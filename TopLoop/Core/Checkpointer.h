@@ -0,0 +1,123 @@
+/*! @file  Checkpointer.h
+ *  @brief TL::Checkpointer class header
+ *  @class TL::Checkpointer
+ *  @brief Periodically saves the progress of an event loop to a file.
+ *
+ *  A checkpoint holds the entry the loop has to continue from, the
+ *  slice of the chain the loop is processing and one list of objects
+ *  per algorithm (see TL::Algorithm::checkpointState). The objects
+ *  are copied on the event loop thread, the file is written by a
+ *  background thread (to a temporary file which then replaces the
+ *  previous checkpoint), so a crash during a write leaves the last
+ *  complete checkpoint in place. A new checkpoint is not due while
+ *  the previous one is still being written, and the interval grows
+ *  if copying the objects takes a noticeable share of the loop time.
+ */
+
+#ifndef TL_Checkpointer_h
+#define TL_Checkpointer_h
+
+// TL
+#include <TopLoop/Core/Loggable.h>
+#include <TopLoop/Core/Utils.h>
+
+// ROOT
+#include <TList.h>
+
+// C++
+#include <chrono>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace TL {
+
+/// Position of an event loop in the chain driving it
+struct CheckpointProgress {
+  /// first entry of the slice processed by the job
+  uint64_t firstEntry{0};
+  /// one past the last entry of the slice processed by the job
+  uint64_t lastEntry{0};
+  /// the entry the loop continues from
+  uint64_t nextEntry{0};
+};
+
+class Checkpointer : public TL::Loggable {
+ private:
+  std::string m_path;
+  std::chrono::seconds m_interval;
+  std::chrono::steady_clock::time_point m_lastSave;
+  std::future<bool> m_pendingWrite{};
+  std::size_t m_nSaved{0};
+  std::size_t m_nSkipped{0};
+  std::chrono::duration<double> m_snapshotTime{0};
+
+  bool writeFile(const TL::CheckpointProgress& progress,
+                 const std::vector<std::unique_ptr<TList>>& states) const;
+
+ public:
+  /// construct with the checkpoint file path and the time between checkpoints
+  Checkpointer(const std::string& path, std::chrono::seconds interval);
+  /// destructor (waits for a pending write)
+  virtual ~Checkpointer();
+
+  /// delete copy constructor
+  Checkpointer(const Checkpointer&) = delete;
+  /// delete assignment operator
+  Checkpointer& operator=(const Checkpointer&) = delete;
+
+  /// the path of the checkpoint file
+  const std::string& path() const { return m_path; }
+
+  /// true if the checkpoint file exists
+  bool exists() const;
+
+  /// true if the interval since the last checkpoint has passed
+  /*!
+   *  and the previous checkpoint has been written
+   */
+  bool due() const;
+
+  /// start writing a checkpoint in the background
+  /*!
+   *  The lists (one per algorithm, owning their objects) are kept
+   *  until the write is done. If the previous checkpoint is still
+   *  being written, this one is skipped.
+   */
+  void save(const TL::CheckpointProgress& progress,
+            std::vector<std::unique_ptr<TList>> states);
+
+  /// add time spent on the event loop thread preparing a checkpoint
+  /*!
+   *  If a snapshot takes more than 5% of the interval, the interval
+   *  is increased so that checkpointing does not stall the loop.
+   */
+  void addSnapshotTime(std::chrono::duration<double> t);
+
+  /// read the last checkpoint
+  /*!
+   *  @return FAILURE if the file cannot be read or is not a valid
+   *  checkpoint.
+   */
+  TL::StatusCode load(TL::CheckpointProgress& progress,
+                      std::vector<std::unique_ptr<TList>>& states) const;
+
+  /// wait for the pending write (if any) to finish
+  /*!
+   *  A failed write only means there is no checkpoint to resume
+   *  from, it is reported as a warning.
+   */
+  void wait();
+
+  /// remove the checkpoint file (when the job is done)
+  void remove() const;
+
+  /// log the number of checkpoints and the time spent on them
+  void report() const;
+};
+
+}  // namespace TL
+
+#endif
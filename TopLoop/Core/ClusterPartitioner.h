@@ -0,0 +1,91 @@
+/*! @file  ClusterPartitioner.h
+ *  @brief TL::ClusterPartitioner class header
+ *  @class TL::ClusterPartitioner
+ *  @brief Splits the entries of a chain into cluster aligned units.
+ *
+ *  ROOT writes the baskets of all branches of a tree in clusters of
+ *  entries. If two jobs (or two threads) process entry ranges which
+ *  share a cluster, both of them read and decompress the baskets of
+ *  that cluster. This class enumerates the clusters of every tree in
+ *  a chain and builds contiguous work units which start and end on
+ *  cluster boundaries, balanced by the compressed size of the active
+ *  branches.
+ */
+
+#ifndef TL_ClusterPartitioner_h
+#define TL_ClusterPartitioner_h
+
+// TL
+#include <TopLoop/Core/Loggable.h>
+#include <TopLoop/Core/Utils.h>
+
+// C++
+#include <cstdint>
+#include <vector>
+
+class TChain;
+
+namespace TL {
+
+/// A contiguous range of global chain entries
+struct WorkUnit {
+  /// first entry of the unit
+  uint64_t first{0};
+  /// one past the last entry of the unit
+  uint64_t last{0};
+  /// compressed bytes of the active branches in the unit
+  uint64_t zipBytes{0};
+  /// number of (possibly partial) clusters in the unit
+  std::size_t nClusters{0};
+  /// number of entries in the unit
+  uint64_t entries() const { return last - first; }
+};
+
+class ClusterPartitioner : public TL::Loggable {
+ private:
+  struct Cluster {
+    uint64_t first;
+    uint64_t last;
+    uint64_t zipBytes;
+  };
+  std::vector<Cluster> m_clusters{};
+
+ public:
+  /// default constructor
+  ClusterPartitioner();
+  /// destructor
+  virtual ~ClusterPartitioner() = default;
+
+  /// Enumerate the clusters of every tree in the chain
+  /*!
+   *  The compressed size of a cluster is the sum of the sizes of the
+   *  baskets of the active (SetBranchStatus) branches starting in the
+   *  cluster. Each file of the chain is opened once.
+   */
+  TL::StatusCode scan(TChain* chain);
+
+  /// Split the entries [first, last) into at most n units
+  /*!
+   *  Units are contiguous, cover the whole range and are balanced by
+   *  compressed bytes (by entries if no size information is
+   *  available). Only the clusters cut by the edges of the range are
+   *  shared with entries outside of it.
+   */
+  std::vector<TL::WorkUnit> partition(std::size_t n, uint64_t first, uint64_t last) const;
+
+  /// Log the units and check that no cluster is shared between them
+  void report(const std::vector<TL::WorkUnit>& units) const;
+
+  /// check if an entry is the first entry of a cluster (or the end of the chain)
+  bool isClusterBoundary(uint64_t entry) const;
+
+  /// the index of the cluster containing an entry (nClusters() if there is none)
+  std::size_t clusterIndex(uint64_t entry) const;
+
+  /// the number of clusters found by the last scan
+  std::size_t nClusters() const { return m_clusters.size(); }
+};
+
+}  // namespace TL
+
+#endif
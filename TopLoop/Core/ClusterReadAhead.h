@@ -0,0 +1,109 @@
+/*! @file  ClusterReadAhead.h
+ *  @brief TL::ClusterReadAhead class header
+ *  @class TL::ClusterReadAhead
+ *  @brief Reads the next clusters of the loop on an I/O thread.
+ *
+ *  The event loop reads the baskets of a cluster when it enters it,
+ *  so it waits for the storage at each cluster boundary. This class
+ *  runs a dedicated I/O thread which reads the compressed baskets of
+ *  the active branches of the clusters after the current one while
+ *  the algorithm processes the current one. The thread stays at most
+ *  @p depth clusters ahead of the loop: the clusters it has read
+ *  form a window which moves with the loop, and the thread waits
+ *  when the window is full (back-pressure). When the loop reaches a
+ *  cluster its baskets are already in memory: in the page cache for
+ *  local files, in the caches between us and the storage (e.g.
+ *  XCache) for remote ones. The baskets are decompressed when the
+ *  TTreeCache is filled, in parallel if TL::Job::enableImplicitMT
+ *  is used.
+ *
+ *  The loop tells the I/O thread where it is with update(), which
+ *  only takes a lock when the loop enters another cluster.
+ */
+
+#ifndef TL_ClusterReadAhead_h
+#define TL_ClusterReadAhead_h
+
+// TL
+#include <TopLoop/Core/Loggable.h>
+
+// ROOT
+#include <RtypesCore.h>
+
+// C++
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+class TChain;
+class TFile;
+class TTree;
+
+namespace TL {
+
+class ClusterReadAhead : public TL::Loggable {
+ private:
+  /// the entries of a cluster and the byte ranges of its baskets
+  struct Cluster {
+    Long64_t first;
+    Long64_t last;
+    std::vector<std::pair<Long64_t, Long64_t>> ranges;
+  };
+  using Clusters = std::vector<Cluster>;
+
+  std::size_t m_depth;
+
+  // only used by the event loop thread
+  Int_t m_treeNumber{-1};
+  std::shared_ptr<const Clusters> m_loopClusters{};
+  std::size_t m_current{0};
+
+  // shared with the I/O thread
+  mutable std::mutex m_mutex{};
+  std::condition_variable m_wakeUp{};
+  std::shared_ptr<const Clusters> m_clusters{};
+  std::string m_fileName{};
+  std::size_t m_generation{0};
+  std::size_t m_loopCluster{0};
+  std::size_t m_readFrom{0};
+  bool m_stop{false};
+  std::size_t m_nRead{0};
+  uint64_t m_nBytes{0};
+  std::size_t m_nFailed{0};
+  std::thread m_worker{};
+
+  void work();
+  static bool readLocal(int fd, const Cluster& cluster, std::vector<char>& buffer);
+  static bool readRemote(TFile& file, const Cluster& cluster, std::vector<char>& buffer);
+  static Clusters clustersOf(TTree* tree);
+
+ public:
+  /// start the I/O thread
+  /*!
+   *  @param depth the number of clusters beyond the current one the
+   *  thread reads
+   */
+  explicit ClusterReadAhead(std::size_t depth);
+  /// destructor, stops the I/O thread
+  virtual ~ClusterReadAhead();
+
+  /// delete copy constructor
+  ClusterReadAhead(const ClusterReadAhead&) = delete;
+  /// delete assignment operator
+  ClusterReadAhead& operator=(const ClusterReadAhead&) = delete;
+
+  /// tell the I/O thread the entry the loop has loaded from a chain
+  void update(const TChain* chain);
+
+  /// log the number of clusters and bytes read ahead
+  void report() const;
+};
+
+}  // namespace TL
+
+#endif
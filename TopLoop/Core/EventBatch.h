@@ -0,0 +1,215 @@
+/*! @file  EventBatch.h
+ *  @brief TL::EventBatch class header
+ *  @class TL::EventBatch
+ *  @brief Columnar view of a window of consecutive entries
+ *
+ *  Holds the values of a set of branches for a window of
+ *  consecutive entries of the main tree, stored as contiguous
+ *  columns: one std::vector per primitive branch, and a flattened
+ *  values vector plus an offsets vector per std::vector branch. It
+ *  is filled by TL::Job and handed to TL::Algorithm::executeBatch, so
+ *  that selections and weight products can be written as loops over
+ *  columns.
+ *
+ *  The primitive columns are read a basket at a time with
+ *  TL::BulkColumn when the branch supports it (one value per entry,
+ *  stored as the requested type), and from a TTreeReaderValue
+ *  otherwise. The jagged columns are filled entry by entry from
+ *  TTreeReaderValues, so for them the I/O is the same as in the per
+ *  event loop, plus a copy of each value.
+ */
+
+#ifndef TL_EventBatch_h
+#define TL_EventBatch_h
+
+// TL
+#include <TopLoop/Core/BulkColumn.h>
+#include <TopLoop/Core/Loggable.h>
+#include <TopLoop/Core/Utils.h>
+
+// ROOT
+#include <TTreeReader.h>
+#include <TTreeReaderValue.h>
+
+// C++
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace TL {
+
+/// A column of a std::vector<T> branch
+/*!
+ *  The elements of entry i of the batch are values[offsets[i]] up to
+ *  (excluding) values[offsets[i+1]].
+ */
+template <typename T>
+struct JaggedColumn {
+  /// batch size + 1 offsets into values
+  std::vector<std::size_t> offsets{0};
+  /// the elements of all entries, one after the other
+  std::vector<T> values{};
+  /// number of elements in entry i of the batch
+  std::size_t size(std::size_t i) const { return offsets[i + 1] - offsets[i]; }
+  /// pointer to the first element of entry i of the batch
+  const T* data(std::size_t i) const { return values.data() + offsets[i]; }
+};
+
+class EventBatch : public TL::Loggable {
+ private:
+  struct ColumnBase {
+    virtual ~ColumnBase() = default;
+    virtual void fill() = 0;
+    virtual void clear() = 0;
+    virtual void reserve(std::size_t n) = 0;
+  };
+
+  template <typename T>
+  struct PrimitiveColumn : public ColumnBase {
+    PrimitiveColumn(TTreeReader& reader, const char* name, const std::size_t& treeChanges) {
+      if (TL::BulkColumn<T>::supported(reader, name)) {
+        bulk = std::make_unique<TL::BulkColumn<T>>(reader, name, treeChanges);
+      }
+      else {
+        value = std::make_unique<TTreeReaderValue<T>>(reader, name);
+      }
+    }
+    void fill() override {
+      if (value != nullptr) {
+        data.push_back(**value);
+        return;
+      }
+      T v{};
+      bulk->read(v);
+      data.push_back(v);
+    }
+    void clear() override { data.clear(); }
+    void reserve(std::size_t n) override { data.reserve(n); }
+    std::unique_ptr<TL::BulkColumn<T>> bulk{nullptr};
+    std::unique_ptr<TTreeReaderValue<T>> value{nullptr};
+    std::vector<T> data{};
+  };
+
+  template <typename T>
+  struct VectorColumn : public ColumnBase {
+    VectorColumn(TTreeReader& reader, const char* name) : value(reader, name) {}
+    void fill() override {
+      const auto& v = *value;
+      data.values.insert(std::end(data.values), std::begin(v), std::end(v));
+      data.offsets.push_back(data.values.size());
+    }
+    void clear() override {
+      data.offsets.resize(1);
+      data.values.clear();
+    }
+    void reserve(std::size_t n) override { data.offsets.reserve(n + 1); }
+    TTreeReaderValue<std::vector<T>> value;
+    JaggedColumn<T> data{};
+  };
+
+  std::map<std::string, std::unique_ptr<ColumnBase>> m_columns{};
+  uint64_t m_firstEntry{0};
+  std::size_t m_size{0};
+
+  bool hasBranch(const std::shared_ptr<TTreeReader>& reader, const std::string& name) const;
+  const ColumnBase* findColumn(const std::string& name) const;
+
+ public:
+  /// default constructor
+  EventBatch();
+  /// destructor
+  virtual ~EventBatch() = default;
+
+  /// delete copy constructor
+  EventBatch(const EventBatch&) = delete;
+  /// delete assignment operator
+  EventBatch& operator=(const EventBatch&) = delete;
+
+  /// @name Column declaration
+  /*!
+   *  Columns must be declared before the event loop starts,
+   *  i.e. in the init() or setupOutput() function of an algorithm
+   *  (see TL::Algorithm::addBatchColumn).
+   */
+  /// @{
+
+  /// add a column for a primitive branch (e.g. Float_t weight_mc)
+  /*!
+   *  @param reader the reader of the tree holding the branch
+   *  @param name the name of the branch
+   *  @param treeChanges incremented whenever the reader is given
+   *  another tree (see TL::BulkColumn)
+   */
+  template <typename T>
+  TL::StatusCode addColumn(const std::shared_ptr<TTreeReader>& reader,
+                           const std::string& name, const std::size_t& treeChanges) {
+    if (not hasBranch(reader, name)) {
+      return TL::StatusCode::FAILURE;
+    }
+    m_columns[name] =
+        std::make_unique<PrimitiveColumn<T>>(*reader, name.c_str(), treeChanges);
+    return TL::StatusCode::SUCCESS;
+  }
+
+  /// add a column for a std::vector<T> branch (e.g. jet_pt)
+  template <typename T>
+  TL::StatusCode addJaggedColumn(const std::shared_ptr<TTreeReader>& reader,
+                                 const std::string& name) {
+    if (not hasBranch(reader, name)) {
+      return TL::StatusCode::FAILURE;
+    }
+    m_columns[name] = std::make_unique<VectorColumn<T>>(*reader, name.c_str());
+    return TL::StatusCode::SUCCESS;
+  }
+
+  /// @}
+
+  /// @name Batch filling (used by TL::Job)
+  /// @{
+
+  /// reserve memory for batches of n entries
+  void reserve(std::size_t n);
+  /// append the current entry of the reader(s) to the columns
+  void fill(uint64_t entry);
+  /// remove all entries from the batch
+  void clear();
+
+  /// @}
+
+  /// @name Batch access
+  /// @{
+
+  /// the number of entries in the batch
+  std::size_t size() const { return m_size; }
+  /// the global entry number of the first entry of the batch
+  uint64_t firstEntry() const { return m_firstEntry; }
+
+  /// the column of a primitive branch (one value per entry)
+  template <typename T>
+  const std::vector<T>& column(const std::string& name) const {
+    auto col = dynamic_cast<const PrimitiveColumn<T>*>(findColumn(name));
+    if (col == nullptr) {
+      logger()->critical("No primitive column {} of the requested type!", name);
+      std::exit(EXIT_FAILURE);
+    }
+    return col->data;
+  }
+
+  /// the column of a std::vector<T> branch
+  template <typename T>
+  const TL::JaggedColumn<T>& jaggedColumn(const std::string& name) const {
+    auto col = dynamic_cast<const VectorColumn<T>*>(findColumn(name));
+    if (col == nullptr) {
+      logger()->critical("No jagged column {} of the requested type!", name);
+      std::exit(EXIT_FAILURE);
+    }
+    return col->data;
+  }
+
+  /// @}
+};
+
+}  // namespace TL
+
+#endif
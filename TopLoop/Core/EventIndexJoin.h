@@ -0,0 +1,122 @@
+/*! @file  EventIndexJoin.h
+ *  @brief TL::EventIndexJoin class header
+ *  @class TL::EventIndexJoin
+ *  @brief Matches reco and particle level entries by event.
+ *
+ *  The reco level and particle level trees of a sample are matched
+ *  on (runNumber, eventNumber). Instead of one TTreeIndex lookup per
+ *  entry, this class reads the two key columns of each chain into
+ *  flat arrays, packs them into 64 bit keys, sorts the keys (radix
+ *  sort) and walks the two sorted lists once (merge join). Keys
+ *  which compare equal are checked on the exact (runNumber,
+ *  eventNumber) pair, so packing collisions cannot produce wrong
+ *  matches.
+ *
+ *  SgTop ntuples store the reco and particle level trees of an event
+ *  in the same file, so the join can also be done file by file on
+ *  several threads (joinPerFile); the per file results are shifted
+ *  by the global entry offsets and concatenated.
+ */
+
+#ifndef TL_EventIndexJoin_h
+#define TL_EventIndexJoin_h
+
+// TL
+#include <TopLoop/Core/Loggable.h>
+#include <TopLoop/Core/Utils.h>
+
+// ROOT
+#include <RtypesCore.h>
+
+// C++
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+class TChain;
+class TTree;
+
+namespace TL {
+
+/// The (runNumber, eventNumber) columns of a chain
+struct EventKeys {
+  /// runNumber of each entry
+  std::vector<UInt_t> runNumber{};
+  /// eventNumber of each entry
+  std::vector<ULong64_t> eventNumber{};
+  /// number of entries
+  std::size_t size() const { return runNumber.size(); }
+};
+
+class EventIndexJoin : public TL::Loggable {
+ private:
+  struct Record {
+    uint64_t key;
+    uint64_t entry;
+  };
+  static uint64_t packKey(UInt_t runNumber, ULong64_t eventNumber);
+  static std::vector<Record> sortedRecords(const TL::EventKeys& keys);
+  TL::StatusCode readTreeKeys(TTree* tree, TL::EventKeys& keys) const;
+  std::size_t matchKeys(const TL::EventKeys& particleLevel, const TL::EventKeys& recoLevel,
+                        std::vector<std::pair<uint64_t, uint64_t>>* particleAndReco,
+                        std::vector<uint64_t>* particleLevelOnly,
+                        std::vector<uint64_t>* recoLevelOnly) const;
+
+ public:
+  /// default constructor
+  EventIndexJoin();
+  /// destructor
+  virtual ~EventIndexJoin() = default;
+
+  /// read the runNumber and eventNumber columns of a chain
+  /*!
+   *  The chain is cloned, only the two key branches are activated
+   *  and read (through a TTreeCache), the original chain is not
+   *  modified.
+   */
+  TL::StatusCode readKeys(const TChain* chain, TL::EventKeys& keys) const;
+
+  /// join the particle level and reco level keys
+  /*!
+   *  Any of the outputs can be null if it's not needed. The outputs
+   *  are in particle level (or reco level, for recoLevelOnly) entry
+   *  order. If several reco entries have the same key, the particle
+   *  level entry is matched to the first one.
+   *
+   *  @param particleLevel the keys of the particle level chain
+   *  @param recoLevel the keys of the reco level chain
+   *  @param particleAndReco (particle level entry, reco entry) pairs of matched events
+   *  @param particleLevelOnly particle level entries without reco match
+   *  @param recoLevelOnly reco level entries without particle level match
+   */
+  void join(const TL::EventKeys& particleLevel, const TL::EventKeys& recoLevel,
+            std::vector<std::pair<uint64_t, uint64_t>>* particleAndReco,
+            std::vector<uint64_t>* particleLevelOnly,
+            std::vector<uint64_t>* recoLevelOnly) const;
+
+  /// check if two chains can be joined file by file
+  /*!
+   *  This is the case if they list the same files in the same order
+   *  (the n-th particle level file holds the particle level trees of
+   *  the events of the n-th reco file). Files are compared by path,
+   *  or by name if one of them is a staged copy.
+   */
+  static bool canJoinPerFile(const TChain* particleLevel, const TChain* recoLevel);
+
+  /// read the keys and join the chains file by file on several threads
+  /*!
+   *  Events are only matched within a file. The outputs are the same
+   *  as the ones of join() (global chain entries, in entry order).
+   *
+   *  @param nThreads the number of threads (at most one per file)
+   */
+  TL::StatusCode joinPerFile(const TChain* particleLevel, const TChain* recoLevel,
+                             std::size_t nThreads,
+                             std::vector<std::pair<uint64_t, uint64_t>>* particleAndReco,
+                             std::vector<uint64_t>* particleLevelOnly,
+                             std::vector<uint64_t>* recoLevelOnly) const;
+};
+
+}  // namespace TL
+
+#endif
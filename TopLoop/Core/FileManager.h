@@ -13,20 +13,50 @@
 #define TL_FileManager_h
 
 // TopLoop
+#include <TopLoop/Core/FilePrefetcher.h>
 #include <TopLoop/Core/Loggable.h>
 #include <TopLoop/Core/SampleMetaSvc.h>
+#include <TopLoop/Core/StagingCache.h>
 #include <TopLoop/Core/Utils.h>
 
 // ROOT
 #include <TChain.h>
 
+// C++
+#include <map>
+
 namespace TL {
 class FileManager : public TL::Loggable {
+ public:
+  /// The chains handled by the FileManager
+  enum class Chain { Main, Weights, ParticleLevel, Truth };
+
+  /// Describes how the TTreeCache of a chain is set up
+  /*!
+   *  The default values leave ROOT's defaults untouched.
+   */
+  struct CachePolicy {
+    /// cache size in bytes (0 disables the cache, -1 keeps ROOT's default)
+    Long64_t size{-1};
+    /// number of entries in the learning phase (-1 keeps ROOT's default)
+    /*!
+     *  ROOT only has one value for all of the caches of the process
+     *  (TTreeCache::SetLearnEntries), so the policies which set it
+     *  must agree.
+     */
+    Int_t learnEntries{-1};
+    /// add the active branches to the cache and skip the learning phase
+    bool cacheActiveBranches{false};
+    /// read the baskets of all active branches during the learning phase
+    bool prefill{false};
+  };
+
  private:
   bool m_doParticleLevel{false};
   std::vector<std::string> m_fileNames{};
   std::string m_plTreeName{"particleLevel"};
   std::string m_treeName{"nominal"};
+  std::vector<std::string> m_treeNames{"nominal"};
   std::string m_weightsTreeName{"sumWeights"};
   std::string m_truthTreeName{"truth"};
   std::unique_ptr<TChain> m_rootChain{nullptr};
@@ -38,11 +68,20 @@ class FileManager : public TL::Loggable {
   bool m_isAFII{false};
   TL::kSgTopNtup m_sgtopNtupVersion{};
   TL::kCampaign m_campaign{};
+  std::map<Chain, CachePolicy> m_cachePolicies{};
+  Long64_t m_cacheBudget{0};
+  mutable std::map<Chain, Long64_t> m_bytesReadAtRebalance{};
+  mutable std::unique_ptr<TL::FilePrefetcher> m_prefetcher{nullptr};
+  bool m_prefetchFiles{false};
+  std::unique_ptr<TL::StagingCache> m_staging{nullptr};
+  std::size_t m_stagingDepth{2};
 
   /// initialize the ROOT TChain pointers
   TL::StatusCode initChain();
   /// uses rucio directory name to determine DSID, ntup version, and campaign
   void determineSampleProperties();
+  /// the path to give to the chains for a file (its local copy if staged)
+  std::string inputPath(const std::string& fileName) const;
 
  public:
   /// Describes instructions to only use a subset of a sgtop ntuple sample
@@ -77,6 +116,15 @@ class FileManager : public TL::Loggable {
   /// determine if particle level has been enabled
   bool particleLevelEnabled() const { return m_doParticleLevel; }
 
+  /// create an independent FileManager with the same files and setup
+  /*!
+   *  The returned FileManager has its own set of chains (fed with the
+   *  same files, in the same order, with the same branch statuses),
+   *  so it can be used on a different thread than this one. The
+   *  sample properties are copied instead of being determined again.
+   */
+  std::unique_ptr<TL::FileManager> clone() const;
+
   /// @name Sample tree naming setup functions
   /*!
    *  By default, the main tree name will be "nominal" and the
@@ -93,6 +141,18 @@ class FileManager : public TL::Loggable {
    */
   void setTreeName(const std::string& tn);
 
+  /// set several main trees to be processed in one pass over the files
+  /*!
+   *  The first tree in the list is the one used to build the main
+   *  chain (e.g. for the algorithm initialization), so it should be
+   *  the tree with the most branches ("nominal" if it is
+   *  processed). TL::Job then opens each file once and loops over
+   *  all of the listed trees in it (see
+   *  TL::Algorithm::currentTreeName). If this function is to be used
+   *  - it must be called before any feeds!
+   */
+  void setTreeNames(const std::vector<std::string>& tns);
+
   /// set the weight tree name to something other than "sumWeights"
   /*!
    *  If this function is to be used - it must be called before any
@@ -149,6 +209,153 @@ class FileManager : public TL::Loggable {
    */
   void disableTruthBranches(const std::vector<std::string>& branch_list) const;
 
+  /// apply the branch statuses of the main chain to a tree
+  /*!
+   *  Used for processing trees read directly from the files (see
+   *  setTreeNames), so that branches disabled in the main chain are
+   *  disabled in the tree as well.
+   */
+  void applyBranchStatus(TTree* tree) const;
+
+  /// @}
+
+  /// @name TTreeCache setup
+  /// @{
+
+  /// set the cache policy of one of the chains
+  /*!
+   *  The policies are applied by TL::Job (see applyCachePolicies)
+   *  after the algorithm is initialized.
+   */
+  void setCachePolicy(Chain chain, const CachePolicy& policy);
+
+  /// the cache policy of one of the chains
+  CachePolicy cachePolicy(Chain chain) const;
+
+  /// set up the TTreeCache of each chain which has a policy
+  /*!
+   *  @return FAILURE if two policies set different learnEntries
+   */
+  TL::StatusCode applyCachePolicies() const;
+
+  /// add the active branches of a tree read by the main reader to its cache again
+  /*!
+   *  Restarting a TTreeReader (see
+   *  TL::Variables::enableLazyBranchConnection) resets the branches
+   *  of the cache of its tree; this applies the cacheActiveBranches
+   *  setting of the Main chain's policy again (if it is set).
+   *
+   *  @param tree the reader's tree (the main chain or one of the
+   *  trees of a file)
+   */
+  void recacheActiveBranches(TTree* tree) const;
+
+  /// log the TTreeCache efficiency and the read calls of each chain
+  /*!
+   *  @param nEvents the number of processed events, used to report
+   *  the read calls per event
+   */
+  void reportCacheStats(std::size_t nEvents) const;
+
+  /// limit the total size of the TTreeCaches of the chains
+  /*!
+   *  The budget is split across the chains read by the event loop
+   *  according to the bytes each of them read since the previous
+   *  split (see rebalanceCaches), chains not read by the loop get no
+   *  cache. It takes precedence over the sizes of the cache
+   *  policies. When a job runs on several threads, each worker gets
+   *  an equal part of the budget.
+   *
+   *  Only the TTreeCache buffers are covered: the baskets ROOT keeps
+   *  for each active branch, the buffer of the read-ahead thread of
+   *  TL::Job, and the memory used outside of the caches, are not
+   *  limited by this budget.
+   *
+   *  @param bytes the budget, 0 (the default) disables it
+   */
+  void setCacheMemoryBudget(Long64_t bytes);
+
+  /// the total size of the TTreeCaches allowed (0 if unlimited)
+  Long64_t cacheMemoryBudget() const { return m_cacheBudget; }
+
+  /// split the cache memory budget across the chains read by the loop
+  /*!
+   *  Each chain gets a minimum of 1 MB (less if the budget is too
+   *  small), the rest is shared in proportion to the bytes read
+   *  since the previous call (equally on the first call). A cache is
+   *  only resized if its size changes by more than 20%, since
+   *  resizing drops its content. Does nothing without a budget.
+   *  TL::Job calls it each time the loop enters a new file, on the
+   *  thread reading the chains.
+   *
+   *  @param chains the chains read by the event loop
+   */
+  void rebalanceCaches(const std::vector<Chain>& chains) const;
+
+  /// @}
+
+  /// @name File prefetching
+  /// @{
+
+  /// warm up the next file of the chains in the background
+  /*!
+   *  TL::Job then asks for the next file (see prefetchNextFile)
+   *  each time the loop moves to a new file, so that the file is
+   *  ready when the loop reaches it (see TL::FilePrefetcher).
+   */
+  void enableFilePrefetch();
+
+  /// check if file prefetching is enabled
+  bool filePrefetchEnabled() const { return m_prefetchFiles; }
+
+  /// warm up the file after the current one of a chain
+  /*!
+   *  Does nothing if prefetching is disabled or if the current file
+   *  is the last one.
+   */
+  void prefetchNextFile(const TChain* chain) const;
+
+  /// warm up a file (if prefetching is enabled)
+  /*!
+   *  Only the branches active in @p chain (the chain the loop reads
+   *  the file with) are read.
+   */
+  void prefetchFile(const std::string& fileName, const std::string& treeName,
+                    const TChain* chain) const;
+
+  /// @}
+
+  /// @name Staging to a local directory
+  /// @{
+
+  /// copy the input files to a local scratch directory
+  /*!
+   *  Files already copied to @p directory (e.g. by a previous job
+   *  over the same sample) are read from there. The others are
+   *  copied in the background, @p depth files ahead of the one being
+   *  processed (see stageUpcoming), and the chains switch to the
+   *  local copy of a file if it is complete when the loop gets
+   *  close to it; otherwise the original file is read. Only files
+   *  on mounted file systems are staged. If this function is to be
+   *  used - it must be called before any feeds!
+   *
+   *  @param directory the scratch directory
+   *  @param maxBytes the cap on the size of the copies in the directory
+   *  @param depth the number of upcoming files to stage
+   */
+  void enableStaging(const std::string& directory, uint64_t maxBytes,
+                     std::size_t depth = 2);
+
+  /// check if staging is enabled
+  bool stagingEnabled() const { return m_staging != nullptr; }
+
+  /// stage the files following the current one of a chain
+  /*!
+   *  Upcoming files whose copy is complete are swapped for the copy
+   *  in all of the chains, the others are queued for copying.
+   */
+  void stageUpcoming(const TChain* chain) const;
+
   /// @}
 
   /// @name Feeding functions
@@ -190,6 +397,8 @@ class FileManager : public TL::Loggable {
   const std::vector<std::string>& fileNames() const { return m_fileNames; }
   /// the name of the main tree being read
   const std::string& treeName() const { return m_treeName; }
+  /// the names of all main trees to be read (see setTreeNames)
+  const std::vector<std::string>& treeNames() const { return m_treeNames; }
   /// the name of the weights tree being read
   const std::string& weightsTreeName() const { return m_weightsTreeName; }
   /// the name of the particle level tree being read
@@ -220,6 +429,8 @@ class FileManager : public TL::Loggable {
   TChain* weightsChain() const { return m_rootWeightsChain.get(); }
   /// getter for the truth chain raw pointer
   TChain* truthChain() const { return m_truthChain.get(); }
+  /// getter for one of the chains (may be null)
+  TChain* chain(Chain chain) const;
 
   /// @}
 
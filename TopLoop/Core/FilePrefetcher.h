@@ -0,0 +1,84 @@
+/*! @file  FilePrefetcher.h
+ *  @brief TL::FilePrefetcher class header
+ *  @class TL::FilePrefetcher
+ *  @brief Warms up the next input file on a background thread.
+ *
+ *  When a chain moves to its next file, the event loop waits for the
+ *  file to be opened, for the TTree metadata to be read and for the
+ *  first baskets to be fetched. While the current file is processed,
+ *  this class reads the beginning and the end of the next file
+ *  (where ROOT writes the first cluster and the file and tree
+ *  metadata) ahead of time: local files are handed to the kernel
+ *  read-ahead (posix_fadvise), remote files are opened and their
+ *  first cluster is read, which fills the caches between us and the
+ *  storage (e.g. XCache); only the branches active in the loop are
+ *  read. A request is skipped while the previous one is still
+ *  running.
+ */
+
+#ifndef TL_FilePrefetcher_h
+#define TL_FilePrefetcher_h
+
+// TL
+#include <TopLoop/Core/Loggable.h>
+
+// C++
+#include <cstdint>
+#include <future>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace TL {
+
+class FilePrefetcher : public TL::Loggable {
+ private:
+  std::future<void> m_pending{};
+  std::string m_lastFile{};
+  std::size_t m_nStarted{0};
+  std::size_t m_nSkipped{0};
+
+  void warmLocal(const std::string& fileName) const;
+  void warmRemote(const std::string& fileName, const std::string& treeName,
+                  const std::vector<std::pair<std::string, bool>>& branchStatus) const;
+
+ public:
+  /// default constructor
+  FilePrefetcher();
+  /// destructor, waits for the running request
+  virtual ~FilePrefetcher();
+
+  /// delete copy constructor
+  FilePrefetcher(const FilePrefetcher&) = delete;
+  /// delete assignment operator
+  FilePrefetcher& operator=(const FilePrefetcher&) = delete;
+
+  /// check if a file name points to the local file system
+  static bool isLocal(const std::string& fileName);
+
+  /// warm up a file in the background
+  /*!
+   *  @param fileName the file to warm up
+   *  @param treeName the tree whose first cluster is read (remote files)
+   *  @param branchStatus the SetBranchStatus calls (branch name or
+   *  pattern, status) made on the loop's chain, in order; only the
+   *  active branches are read
+   */
+  void prefetch(const std::string& fileName, const std::string& treeName,
+                const std::vector<std::pair<std::string, bool>>& branchStatus);
+
+  /// wait for the running request (if any)
+  void wait();
+
+  /// the number of files warmed up (or being warmed up)
+  std::size_t nStarted() const { return m_nStarted; }
+  /// the number of requests skipped because the previous one was running
+  std::size_t nSkipped() const { return m_nSkipped; }
+
+  /// log the number of files warmed up and of skipped requests
+  void report() const;
+};
+
+}  // namespace TL
+
+#endif
@@ -0,0 +1,76 @@
+/*! @file  IndexCache.h
+ *  @brief TL::IndexCache class header
+ *  @class TL::IndexCache
+ *  @brief Stores the reco <-> particle level join on disk.
+ *
+ *  The result of the reco <-> particle level join (see
+ *  TL::EventIndexJoin) only depends on the input files. This class
+ *  saves the index vectors in a binary sidecar file, named after a
+ *  fingerprint of the inputs (file names, sizes and modification
+ *  times, tree names), so that the next job on the same sample can
+ *  load them instead of reading and joining the event keys again.
+ */
+
+#ifndef TL_IndexCache_h
+#define TL_IndexCache_h
+
+// TL
+#include <TopLoop/Core/Loggable.h>
+#include <TopLoop/Core/Utils.h>
+
+// C++
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace TL {
+
+class IndexCache : public TL::Loggable {
+ private:
+  uint64_t m_fingerprint{0};
+  std::string m_path{};
+
+ public:
+  /// construct for a sample, the cache file lives in @p directory
+  /*!
+   *  @p fileNames are the input files as given to the job (see
+   *  TL::FileManager::fileNames), not the chain titles, which point
+   *  to local copies when the inputs are staged.
+   */
+  IndexCache(const std::string& directory, const std::vector<std::string>& fileNames,
+             const std::string& recoTreeName, const std::string& particleLevelTreeName);
+  /// destructor
+  virtual ~IndexCache() = default;
+
+  /// the path of the cache file of the sample
+  const std::string& path() const { return m_path; }
+
+  /// the fingerprint of the sample inputs
+  /*!
+   *  A 64 bit FNV-1a hash of the tree names and of the name, size
+   *  and modification time of each input file. Remote files (which
+   *  cannot be checked without opening them) only contribute their
+   *  names.
+   */
+  static uint64_t fingerprint(const std::vector<std::string>& fileNames,
+                              const std::string& recoTreeName,
+                              const std::string& particleLevelTreeName);
+
+  /// load the index vectors
+  /*!
+   *  @return false if there is no (valid) cache file for the sample
+   */
+  bool load(std::vector<std::pair<uint64_t, uint64_t>>& particleAndReco,
+            std::vector<uint64_t>& particleLevelOnly,
+            std::vector<uint64_t>& recoLevelOnly) const;
+
+  /// save the index vectors
+  TL::StatusCode save(const std::vector<std::pair<uint64_t, uint64_t>>& particleAndReco,
+                      const std::vector<uint64_t>& particleLevelOnly,
+                      const std::vector<uint64_t>& recoLevelOnly) const;
+};
+
+}  // namespace TL
+
+#endif
@@ -14,11 +14,20 @@
 #include <TopLoop/Core/Loggable.h>
 #include <TopLoop/Core/Utils.h>
 
+#include <functional>
+#include <limits>
+#include <memory>
+#include <string>
 #include <utility>
 #include <vector>
 
+class TChain;
+
 namespace TL {
 class Algorithm;
+class Checkpointer;
+class ClusterPartitioner;
+class ClusterReadAhead;
 class FileManager;
 }  // namespace TL
 
@@ -33,9 +42,21 @@ enum class LoopType {
   RecoOnly           ///< Loop over reco events which are not in particle level
 };
 
+/// enum for declaring the order of the RecoWithParticle loop
+enum class IndexOrder {
+  ParticleLevel,  ///< Particle level entry order (the order of the join)
+  RecoLevel,      ///< Reco entry order, the reco tree is read sequentially
+  Clustered       ///< Reco cluster, then particle level cluster, then reco entry
+};
+
 class Job : public TL::Loggable {
+ public:
+  /// function type used to create new instances of the user's algorithm
+  using AlgorithmFactory = std::function<std::unique_ptr<TL::Algorithm>()>;
+
  protected:
   std::unique_ptr<TL::Algorithm> m_algorithm{nullptr};
+  std::vector<std::unique_ptr<TL::Algorithm>> m_coAlgorithms{};
   std::unique_ptr<TL::FileManager> m_fm{nullptr};
 
  private:
@@ -44,9 +65,57 @@ class Job : public TL::Loggable {
   std::vector<uint64_t> m_particleLevelOnly{};
   std::vector<uint64_t> m_recoLevelOnly{};
   std::vector<std::pair<uint64_t, uint64_t>> m_particleAndReco{};
+  std::size_t m_nThreads{1};
+  AlgorithmFactory m_algorithmFactory{};
+  uint64_t m_rangeFirst{0};
+  uint64_t m_rangeLast{std::numeric_limits<uint64_t>::max()};
+  std::size_t m_shardIndex{0};
+  std::size_t m_nShards{1};
+  std::size_t m_readAheadDepth{0};
+  std::shared_ptr<TL::ClusterReadAhead> m_readAhead{nullptr};
+  std::size_t m_batchSize{0};
+  std::string m_checkpointPath{};
+  unsigned int m_checkpointInterval{600};
+  bool m_resume{false};
+  std::string m_indexCacheDir{};
+  IndexOrder m_indexOrder{IndexOrder::RecoLevel};
+  std::size_t m_nIndexThreads{0};
+  bool m_lazyParticleLevel{false};
+  Int_t m_loopTreeNumber{-1};
+  bool m_implicitMT{false};
+  std::size_t m_nImplicitMTThreads{0};
+  uint64_t m_autoPruneEvents{0};
+  uint64_t m_nAutoPruneSeen{0};
+  bool m_branchesPruned{false};
 
  private:
   TL::StatusCode constructIndices();
+  void keepLoopIndices();
+  TL::StatusCode initAlgorithm(TL::Algorithm* alg) const;
+  TL::StatusCode initCoAlgorithms();
+  TL::StatusCode loopTreesPerFile();
+  void disableUnusedBranches() const;
+  void autoPruneStep();
+  void pruneUnusedBranches();
+  void logReadBranches() const;
+  void syncCoAlgorithms();
+  TL::StatusCode executeEvent();
+  TL::StatusCode flushBatches();
+  TL::StatusCode finishAlgorithms();
+  TL::StatusCode maybeCheckpoint(TL::Checkpointer* checkpointer, uint64_t sliceFirst,
+                                 uint64_t sliceLast, uint64_t nextEntry);
+  TL::StatusCode restoreCheckpoint(TL::Checkpointer& checkpointer, uint64_t& firstEntry,
+                                   uint64_t lastEntry);
+  TL::StatusCode runMultiThreaded();
+  std::pair<uint64_t, uint64_t> loopEntryRange(TChain* chain,
+                                               TL::ClusterPartitioner& partitioner) const;
+  void applyEntryRangeToIndices(uint64_t first, uint64_t last);
+  TL::StatusCode orderParticleAndReco();
+  void setParticleLevelEntry(uint64_t entry) const;
+  TL::StatusCode batchStep(TL::Algorithm* alg) const;
+  TL::StatusCode flushBatch(TL::Algorithm* alg) const;
+  void configureImplicitMT() const;
+  void configureParallelUnzip(const TL::FileManager* fm) const;
   void printProgress(int, long, long) const;
 
  public:
@@ -67,23 +136,236 @@ class Job : public TL::Loggable {
   /// function to set the algorithm the job will run
   TL::StatusCode setAlgorithm(std::unique_ptr<TL::Algorithm> alg);
 
+  /// add an algorithm to run over the same read of the data
+  /*!
+   *  The first algorithm added (or the one given to setAlgorithm) is
+   *  the primary algorithm, the others share its FileManager and
+   *  TTreeReaders: each entry is read and decompressed once and
+   *  dispatched to the execute() function of every algorithm, in the
+   *  order they were added. The branches disabled by the job are the
+   *  ones unused by all of the algorithms (see
+   *  TL::Algorithm::setUnusedBranches). Cannot be combined with
+   *  multi-threaded running.
+   */
+  TL::StatusCode addAlgorithm(std::unique_ptr<TL::Algorithm> alg);
+
   /// function to set the file manager for the job
   TL::StatusCode setFileManager(std::unique_ptr<TL::FileManager> fm);
 
+  /// function to set the factory used to create copies of the algorithm
+  /*!
+   *  Required for multi-threaded running (see setNumThreads). Each
+   *  call of the factory must return a new, independent instance of
+   *  the user's algorithm, e.g.
+   *
+   *  @code{.cpp}
+   *  job.setAlgorithmFactory([] { return std::make_unique<MyAlgorithm>(); });
+   *  @endcode
+   *
+   *  If no algorithm is given with setAlgorithm, the primary
+   *  algorithm is also created with the factory.
+   */
+  TL::StatusCode setAlgorithmFactory(AlgorithmFactory factory);
+
+  /// set the number of threads used to process the event loop
+  /*!
+   *  With more than one thread the entries of the chain are split
+   *  into cluster aligned work units (a few per thread, see
+   *  TL::ClusterPartitioner) which the threads process as they
+   *  become free. Each thread runs its own
+   *  replica of the algorithm (built with the algorithm factory),
+   *  with its own FileManager, TTreeReaders and branch
+   *  connections. When all threads are done the replicas are merged
+   *  into the primary algorithm (see TL::Algorithm::merge) and
+   *  finish() is called on the primary algorithm only.
+   *
+   *  Only the RecoStandard and ParticleAll loop types can be run on
+   *  multiple threads.
+   */
+  void setNumThreads(std::size_t n);
+
+  /// read the next clusters of the loop on a dedicated I/O thread
+  /*!
+   *  While the algorithm processes a cluster of the chain driving
+   *  the loop, a TL::ClusterReadAhead thread reads the compressed
+   *  baskets of the active branches of the next @p depth clusters,
+   *  so the event loop does not wait for the storage when it enters
+   *  them. The thread waits when it is @p depth clusters ahead. The
+   *  TTreeCache sizes are not changed, and the baskets are still
+   *  decompressed by the event loop thread when the cache is filled
+   *  (see enableImplicitMT to unzip them in parallel).
+   *
+   *  Only supported by the single threaded loops over one tree per
+   *  pass.
+   *
+   *  @param depth the number of clusters beyond the current one the
+   *  I/O thread reads
+   */
+  void enableReadAhead(std::size_t depth = 2);
+
+  /// unzip the baskets of different branches in parallel
+  /*!
+   *  Enables ROOT's implicit multi-threading and parallel unzipping
+   *  of the TTreeCache of the chains read by the loop: the baskets
+   *  of a cluster are decompressed by the implicit MT pool instead
+   *  of one at a time by the event loop thread, which pays off for
+   *  the ~700 branches of the reco tree.
+   *
+   *  The pool is sized to leave room for the TopLoop worker threads
+   *  (see setNumThreads): it gets @p nThreads minus the number of
+   *  workers, and is not enabled if that leaves less than two
+   *  threads. If ROOT's implicit MT is already enabled its pool is
+   *  used as is.
+   *
+   *  @param nThreads the total number of threads of the job, 0 for
+   *  one per core
+   */
+  void enableImplicitMT(std::size_t nThreads = 0);
+
+  /// run the algorithm in batch mode
+  /*!
+   *  Instead of calling TL::Algorithm::execute for each entry, the
+   *  entries are collected in windows of @p n consecutive entries
+   *  (the last window of the loop can be smaller) and
+   *  TL::Algorithm::executeBatch is called for each window. The
+   *  entries are still read one at a time (see TL::EventBatch). Only
+   *  the RecoStandard loop type supports batch mode. A size of 0
+   *  turns batch mode off.
+   */
+  void setBatchSize(std::size_t n);
+
+  /// @name Checkpointing (for long jobs)
+  /// @{
+
+  /// periodically save the progress of the job to a checkpoint file
+  /*!
+   *  Every @p seconds (checked between events) the next entry of the
+   *  loop, the event counter and the state of the algorithm(s) (see
+   *  TL::Algorithm::checkpointState) are saved to @p path. The
+   *  objects are copied on the event loop thread and written in the
+   *  background; the time spent in the event loop is reported at the
+   *  end of the job. The file is removed when the job finishes
+   *  successfully. Only the single threaded RecoStandard and
+   *  ParticleAll loops support checkpointing.
+   */
+  void enableCheckpointing(const std::string& path, unsigned int seconds = 600);
+
+  /// resume the job from the checkpoint file (if it exists)
+  /*!
+   *  Requires enableCheckpointing. The job must process the same
+   *  sample and slice (see setEntryRange and setShard) as the one
+   *  which wrote the checkpoint. If the file doesn't exist the job
+   *  starts from the beginning, so the same configuration can be
+   *  used for the first attempt and for the retries.
+   */
+  void resumeFromCheckpoint();
+
+  /// @}
+
+  /// @name Entry slicing (for splitting a sample across batch jobs)
+  /*!
+   *  The entry numbers refer to the global chain driving the loop:
+   *  the main (reco) chain for the RecoStandard, RecoWithParticle
+   *  and RecoOnly loop types, the particle level chain for the
+   *  ParticleAll and ParticleOnly loop types. For the loop types
+   *  based on reco <-> particle level indices, only the events whose
+   *  driving entry is in the slice are processed.
+   */
+  /// @{
+
+  /// restrict the loop to the entries [first, last) of the chain
+  void setEntryRange(uint64_t first, uint64_t last);
+
+  /// restrict the loop to shard i of n equal shares of the chain
+  /*!
+   *  If an entry range is also set, the range is split into the
+   *  shards. The n shards of a sample (i = 0 ... n-1) cover every
+   *  entry exactly once. Shards are aligned to the ROOT clusters of
+   *  the chain and balanced by compressed bytes (see
+   *  TL::ClusterPartitioner).
+   */
+  TL::StatusCode setShard(std::size_t i, std::size_t n);
+
+  /// @}
+
   /// launches the TL::Algorithm and checks the steps.
   TL::StatusCode run();
 
   /// disable the tqdm-like progress bar
   void disableProgressBar();
 
+  /// save and reuse the reco <-> particle level indices
+  /*!
+   *  The indices used by the RecoWithParticle, ParticleOnly and
+   *  RecoOnly loop types are saved to a binary file in @p directory,
+   *  named after a fingerprint of the input files (see
+   *  TL::IndexCache). Later jobs on the same files load the indices
+   *  from the file instead of computing them again.
+   */
+  void enableIndexCache(const std::string& directory = ".");
+
+  /// set the number of threads used to build the reco <-> particle level indices
+  /*!
+   *  If the reco and particle level chains have the same number of
+   *  files, the indices are built file by file on @p n threads (see
+   *  TL::EventIndexJoin::joinPerFile). The default (0) uses one
+   *  thread per core.
+   */
+  void setNumIndexThreads(std::size_t n);
+
   /// Set which kind of loop to execute on the algorithm
   /*!
    * options are any of the members of the LoopType enumeration.  If
-   * the type is anything other than LoopType::RecoOnly, there will
-   * be some overhead determining the reco-level <-> particle-level
-   * indices.
+   * the type is RecoWithParticle, ParticleOnly or RecoOnly, there
+   * will be some overhead determining the reco-level <->
+   * particle-level indices.
    */
   void setLoopType(const TL::LoopType loopType);
+
+  /// Set the order of the RecoWithParticle loop
+  /*!
+   *  By default the matched pairs are processed in reco entry order
+   *  (IndexOrder::RecoLevel), so that the (much larger) reco tree is
+   *  read sequentially and each of its baskets is decompressed
+   *  once. IndexOrder::Clustered also groups the pairs by particle
+   *  level cluster within each reco cluster, at the cost of scanning
+   *  the clusters of both chains. Use IndexOrder::ParticleLevel to
+   *  keep the original particle level order.
+   */
+  void setIndexOrder(const TL::IndexOrder indexOrder);
+
+  /// read the particle level and truth entries only when they are used
+  /*!
+   *  In the RecoWithParticle and ParticleOnly loops the particle
+   *  level and truth readers are then only set to the current event
+   *  on the first call of a PL_* or truth_* accessor, so events
+   *  rejected on reco quantities never read the particle level or
+   *  truth baskets. TTreeReaderValues connected by hand to
+   *  TL::Algorithm::particleLevelReader or TL::Algorithm::truthReader
+   *  must be preceded by a call to loadParticleLevelEntry or
+   *  loadTruthEntry (see TL::Variables).
+   */
+  void enableLazyParticleLevel();
+
+  /// disable the branches the algorithm(s) did not use in the first events
+  /*!
+   *  The branches of the main tree are then connected when they are
+   *  first used (see TL::Variables::enableLazyBranchConnection).
+   *  After @p nEvents events, every branch of the main, particle
+   *  level and truth chains which no algorithm has connected through
+   *  TL::Variables (the CONNECT_* macros, the accessors and
+   *  TL::Variables::setupBranch, which the weight variations use)
+   *  is disabled (SetBranchStatus) and dropped from the TTreeCache.
+   *  Values created directly on a reader are not seen and must not
+   *  be used with this setting. A chain whose reader has not loaded
+   *  an entry yet is left untouched. A main tree branch whose
+   *  accessor is first called later on is enabled again (with a
+   *  warning) and read for the current event; values connected with
+   *  setupBranch must be connected before the loop. The active branches of each chain
+   *  are logged at the end of the loop. Only supported by the single
+   *  threaded loops without batch mode.
+   */
+  void enableBranchAutoPrune(uint64_t nEvents = 1000);
 };
 
 }  // namespace TL
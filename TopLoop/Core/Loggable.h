@@ -16,6 +16,9 @@
 // avoid clang-format reorder
 #include <TopLoop/spdlog/sinks/stdout_color_sinks.h>
 
+// C++
+#include <mutex>
+
 namespace TL {
 class Loggable {
  protected:
@@ -67,7 +70,16 @@ class Loggable {
       }
       loggername.append("...");
     }
-    return spdlog::stdout_color_st(loggername);
+    // multiple instances of a class (e.g. algorithm replicas in a
+    // multi-threaded job) share the same logger; the lookup and the
+    // creation must not be interleaved with another thread's
+    static std::mutex registryMutex;
+    std::lock_guard<std::mutex> lock(registryMutex);
+    auto existing = spdlog::get(loggername);
+    if (existing != nullptr) {
+      return existing;
+    }
+    return spdlog::stdout_color_mt(loggername);
   }
 
   /// set the level of the logger (see spdlog documentation for levels)
@@ -0,0 +1,107 @@
+/*! @file  StagingCache.h
+ *  @brief TL::StagingCache class header
+ *  @class TL::StagingCache
+ *  @brief Copies input files to a local scratch directory.
+ *
+ *  Reading from a high latency (e.g. FUSE mounted) file system is
+ *  slow, reading a local copy is not. This class copies input files
+ *  to a local directory on a background thread, in the order they
+ *  are requested. A copy is written to a temporary file which is
+ *  flushed to disk and renamed when complete, so a file in the
+ *  directory is always a complete copy. Copies are named after the
+ *  path and modification time of the original, so a copy of an
+ *  older version of a file is never used. The directory is shared by all jobs using it:
+ *  later jobs over the same sample find the copies already there.
+ *  The total size of the copies is kept under a cap by removing the
+ *  least recently used ones (the modification time of a copy is
+ *  updated each time it is used).
+ *
+ *  The copies a job uses are pinned on disk: each job lists them in
+ *  its own pins file in the directory, which it keeps locked (flock)
+ *  while it runs. A copy listed by a running job is never removed,
+ *  and pinning and removing copies are serialized by a lock file in
+ *  the directory, so a copy cannot disappear between the moment a
+ *  job resolves it and the moment the job opens it. The pins of a
+ *  job which died are dropped by the next job making room.
+ */
+
+#ifndef TL_StagingCache_h
+#define TL_StagingCache_h
+
+// TL
+#include <TopLoop/Core/Loggable.h>
+
+// C++
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+
+namespace TL {
+
+class StagingCache : public TL::Loggable {
+ private:
+  std::string m_directory;
+  uint64_t m_maxBytes;
+  std::deque<std::string> m_queue{};
+  std::set<std::string> m_requested{};
+  std::set<std::string> m_pinned{};
+  std::string m_pinsPath{};
+  int m_pinsFd{-1};
+  mutable std::mutex m_mutex{};
+  std::condition_variable m_wakeUp{};
+  bool m_stop{false};
+  std::size_t m_nHits{0};
+  std::size_t m_nStaged{0};
+  std::size_t m_nFailed{0};
+  std::thread m_worker{};
+
+  void work();
+  bool copy(const std::string& source);
+  bool makeRoom(uint64_t bytes);
+  std::set<std::string> pinnedByOthers() const;
+
+ public:
+  /// construct with the scratch directory and the cap on its size (in bytes)
+  StagingCache(const std::string& directory, uint64_t maxBytes);
+  /// destructor, waits for the running copy, drops the queued ones and the pins
+  virtual ~StagingCache();
+
+  /// delete copy constructor
+  StagingCache(const StagingCache&) = delete;
+  /// delete assignment operator
+  StagingCache& operator=(const StagingCache&) = delete;
+
+  /// the scratch directory
+  const std::string& directory() const { return m_directory; }
+
+  /// the path of the local copy of a file
+  std::string localPath(const std::string& source) const;
+
+  /// check if a file has a complete local copy
+  bool isStaged(const std::string& source) const;
+
+  /// the local copy of a file if there is one, the file itself otherwise
+  /*!
+   *  A local copy which is used is marked as recently used, and is
+   *  pinned: no job removes it while this one runs.
+   */
+  std::string resolve(const std::string& source);
+
+  /// copy a file to the scratch directory in the background
+  /*!
+   *  Does nothing if the file is already staged or requested, or if
+   *  it is not on a mounted file system (e.g. a root:// URL).
+   */
+  void stage(const std::string& source);
+
+  /// log the number of local copies used and made
+  void report() const;
+};
+
+}  // namespace TL
+
+#endif
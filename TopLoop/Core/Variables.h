@@ -15,36 +15,90 @@
 #define TL_Variables_h
 
 // C++
+#include <functional>
+#include <map>
 #include <memory>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 // ROOT
 #include <TTreeReader.h>
+#include <TTreeReaderArray.h>
 #include <TTreeReaderValue.h>
 
 // TopLoop
+#include <TopLoop/Core/BulkColumn.h>
 #include <TopLoop/Core/Loggable.h>
 
 #define DECLARE_BRANCH(NAME, TYPE)                                 \
  protected:                                                        \
-  std::unique_ptr<TTreeReaderValue<TYPE>> bv__##NAME;              \
+  mutable std::unique_ptr<TTreeReaderValue<TYPE>> bv__##NAME;      \
+  mutable bool bl__##NAME{false};                                  \
                                                                    \
  public:                                                           \
   const TYPE& NAME() const {                                       \
     if (bv__##NAME) return *(*bv__##NAME);                         \
+    if (TL::Variables::connectLazily(bl__##NAME, #NAME, [this] {   \
+          TL_SETUP_BRANCH(NAME, TYPE, m_lazyReader)                \
+        })) {                                                      \
+      return NAME();                                               \
+    }                                                              \
     spdlog::get("BranchAccess")->critical("No {} branch!", #NAME); \
     std::exit(EXIT_FAILURE);                                       \
   }
 
-#define DECLARE_BRANCH_PRIMITIVE(NAME, TYPE)                       \
- protected:                                                        \
-  std::unique_ptr<TTreeReaderValue<TYPE>> bv__##NAME;              \
-                                                                   \
- public:                                                           \
-  TYPE NAME() const {                                              \
-    if (bv__##NAME) return *(*bv__##NAME);                         \
-    spdlog::get("BranchAccess")->critical("No {} branch!", #NAME); \
-    std::exit(EXIT_FAILURE);                                       \
+#define DECLARE_BRANCH_PRIMITIVE(NAME, TYPE)                         \
+ protected:                                                          \
+  mutable std::unique_ptr<TTreeReaderValue<TYPE>> bv__##NAME;        \
+  mutable std::unique_ptr<TL::BulkColumn<TYPE>> bb__##NAME;          \
+  mutable bool bl__##NAME{false};                                    \
+                                                                     \
+ public:                                                             \
+  TYPE NAME() const {                                                \
+    if (bv__##NAME) return *(*bv__##NAME);                           \
+    TYPE bulkValue;                                                  \
+    if (bb__##NAME && bb__##NAME->read(bulkValue)) return bulkValue; \
+    if (TL::Variables::connectLazily(bl__##NAME, #NAME, [this] {     \
+          TL_SETUP_PRIMITIVE_BRANCH(NAME, TYPE, m_lazyReader)        \
+        })) {                                                        \
+      return NAME();                                                 \
+    }                                                                \
+    spdlog::get("BranchAccess")->critical("No {} branch!", #NAME);   \
+    std::exit(EXIT_FAILURE);                                         \
+  }
+
+#define DECLARE_VECTOR_BRANCH(NAME, TYPE)                                     \
+ protected:                                                                   \
+  mutable std::unique_ptr<TTreeReaderValue<std::vector<TYPE>>> bv__##NAME;    \
+  mutable std::unique_ptr<TTreeReaderArray<TYPE>> ba__##NAME;                 \
+  mutable std::vector<TYPE> bc__##NAME;                                       \
+  mutable bool bl__##NAME{false};                                             \
+                                                                              \
+ public:                                                                      \
+  const std::vector<TYPE>& NAME() const {                                     \
+    if (bv__##NAME) return *(*bv__##NAME);                                    \
+    if (ba__##NAME) return TL::Variables::copyArray(*ba__##NAME, bc__##NAME); \
+    if (TL::Variables::connectLazily(bl__##NAME, #NAME, [this] {              \
+          TL_SETUP_VECTOR_BRANCH(NAME, TYPE, m_lazyReader)                    \
+        })) {                                                                 \
+      return NAME();                                                          \
+    }                                                                         \
+    spdlog::get("BranchAccess")->critical("No {} branch!", #NAME);            \
+    std::exit(EXIT_FAILURE);                                                  \
+  }                                                                           \
+  TL::ArrayView<TYPE> view_##NAME() const {                                   \
+    if (ba__##NAME) return TL::Variables::viewArray(*ba__##NAME);             \
+    if (bv__##NAME) return {(*bv__##NAME)->data(), (*bv__##NAME)->size()};    \
+    if (TL::Variables::connectLazily(bl__##NAME, #NAME, [this] {              \
+          TL_SETUP_VECTOR_BRANCH(NAME, TYPE, m_lazyReader)                    \
+        })) {                                                                 \
+      return view_##NAME();                                                   \
+    }                                                                         \
+    spdlog::get("BranchAccess")->critical("No {} branch!", #NAME);            \
+    std::exit(EXIT_FAILURE);                                                  \
   }
 
 #define DECLARE_PL_BRANCH(NAME, TYPE)                                 \
@@ -53,6 +107,7 @@
                                                                       \
  public:                                                              \
   const TYPE& PL_##NAME() const {                                     \
+    m_lazyParticleLevel->load();                                      \
     if (bv__pl__##NAME) return *(*bv__pl__##NAME);                    \
     spdlog::get("BranchAccess")->critical("No PL_{} branch!", #NAME); \
     std::exit(EXIT_FAILURE);                                          \
@@ -64,6 +119,7 @@
                                                                       \
  public:                                                              \
   TYPE PL_##NAME() const {                                            \
+    m_lazyParticleLevel->load();                                      \
     if (bv__pl__##NAME) return *(*bv__pl__##NAME);                    \
     spdlog::get("BranchAccess")->critical("No PL_{} branch!", #NAME); \
     std::exit(EXIT_FAILURE);                                          \
@@ -75,22 +131,109 @@
                                                                          \
  public:                                                                 \
   TYPE truth_##NAME() const {                                            \
+    m_lazyTruth->load();                                                 \
     if (bv__truth__##NAME) return *(*bv__truth__##NAME);                 \
     spdlog::get("BranchAccess")->critical("No truth_{} branch!", #NAME); \
     std::exit(EXIT_FAILURE);                                             \
   }
 
-#define CONNECT_BRANCH(NAME, TYPE, READER) \
+#define TL_SETUP_BRANCH(NAME, TYPE, READER)                                         \
   bv__##NAME = TL::Variables::setupBranch<TTreeReaderValue<TYPE>>((READER), #NAME);
 
-#define CONNECT_PL_BRANCH(NAME, TYPE, READER) \
+#define TL_SETUP_VECTOR_BRANCH(NAME, TYPE, READER)                                        \
+  if (arrayBranchAccess()) {                                                              \
+    ba__##NAME = TL::Variables::setupBranch<TTreeReaderArray<TYPE>>((READER), #NAME);     \
+  }                                                                                       \
+  else {                                                                                  \
+    bv__##NAME =                                                                          \
+        TL::Variables::setupBranch<TTreeReaderValue<std::vector<TYPE>>>((READER), #NAME); \
+  }
+
+#define TL_SETUP_PRIMITIVE_BRANCH(NAME, TYPE, READER)                                 \
+  if (bulkBranchAccess() && TL::Variables::hasBranch((READER)->GetTree(), #NAME) &&   \
+      TL::BulkColumn<TYPE>::supported(*(READER), #NAME)) {                            \
+    bb__##NAME = std::make_unique<TL::BulkColumn<TYPE>>(*(READER), #NAME,             \
+                                                        m_readerTreeChanges);         \
+    m_connectedBranches.emplace(#NAME);                                               \
+  }                                                                                   \
+  else {                                                                              \
+    bv__##NAME = TL::Variables::setupBranch<TTreeReaderValue<TYPE>>((READER), #NAME); \
+  }
+
+#define CONNECT_BRANCH(NAME, TYPE, READER)     \
+  if (!TL::Variables::deferBranch((READER))) { \
+    TL_SETUP_BRANCH(NAME, TYPE, READER)        \
+  }
+
+#define CONNECT_VECTOR_BRANCH(NAME, TYPE, READER)              \
+  TL::Variables::registerAccessor(#NAME, &TL::Variables::NAME); \
+  if (!TL::Variables::deferBranch((READER))) {                 \
+    TL_SETUP_VECTOR_BRANCH(NAME, TYPE, READER)                 \
+  }
+
+#define CONNECT_PRIMITIVE_BRANCH(NAME, TYPE, READER)           \
+  TL::Variables::registerAccessor(#NAME, &TL::Variables::NAME); \
+  if (!TL::Variables::deferBranch((READER))) {                 \
+    TL_SETUP_PRIMITIVE_BRANCH(NAME, TYPE, READER)              \
+  }
+
+#define CONNECT_PL_BRANCH(NAME, TYPE, READER)                                           \
   bv__pl__##NAME = TL::Variables::setupBranch<TTreeReaderValue<TYPE>>((READER), #NAME);
 
-#define CONNECT_TRUTH_BRANCH(NAME, TYPE, READER) \
+#define CONNECT_TRUTH_BRANCH(NAME, TYPE, READER)                                           \
   bv__truth__##NAME = TL::Variables::setupBranch<TTreeReaderValue<TYPE>>((READER), #NAME);
 
 namespace TL {
 
+/// A read-only view of contiguous elements (e.g. of a vector branch)
+template <typename T>
+struct ArrayView {
+  /// pointer to the first element
+  const T* ptr{nullptr};
+  /// number of elements
+  std::size_t n{0};
+
+  /// pointer to the first element
+  const T* data() const { return ptr; }
+  /// number of elements
+  std::size_t size() const { return n; }
+  /// check if there are no elements
+  bool empty() const { return n == 0; }
+  /// access an element (unchecked)
+  const T& operator[](std::size_t i) const { return ptr[i]; }
+  /// iterator to the first element
+  const T* begin() const { return ptr; }
+  /// iterator past the last element
+  const T* end() const { return ptr + n; }
+  /// copy the elements to a std::vector
+  std::vector<T> toVector() const { return std::vector<T>(begin(), end()); }
+};
+
+/// Positions a TTreeReader on an entry when it is first needed
+class LazyEntry {
+ private:
+  TTreeReader* m_reader{nullptr};
+  Long64_t m_entry{-1};
+  bool m_pending{false};
+
+ public:
+  /// the reader will be set to @p entry by the next load()
+  void set(TTreeReader* reader, Long64_t entry) {
+    m_reader = reader;
+    m_entry = entry;
+    m_pending = true;
+  }
+  /// set the reader to the pending entry (if any)
+  void load() {
+    if (m_pending) {
+      m_pending = false;
+      m_reader->SetEntry(m_entry);
+    }
+  }
+  /// forget the pending entry
+  void clear() { m_pending = false; }
+};
+
 class Variables {
  public:
   /// default constructor
@@ -103,12 +246,97 @@ class Variables {
   /// disable assignment operator
   Variables& operator=(const Variables&) = delete;
 
+  /// connect the vector branches of the main tree as TTreeReaderArrays
+  /*!
+   *  By default a std::vector<T> branch (e.g. jet_pt) is read with a
+   *  TTreeReaderValue<std::vector<T>>. With this setting (which must
+   *  be enabled before the algorithm is initialized, e.g. in its
+   *  constructor) all of them are read with a TTreeReaderArray<T>
+   *  instead, and their elements are accessed in place through the
+   *  view_* accessors (e.g. view_jet_pt()), which return a
+   *  TL::ArrayView. The view_* accessors work in both modes; in
+   *  array mode the std::vector accessors still work, but they copy
+   *  the elements.
+   */
+  void enableArrayBranchAccess() { m_arrayBranchAccess = true; }
+
+  /// check if the vector branches are connected as TTreeReaderArrays
+  bool arrayBranchAccess() const { return m_arrayBranchAccess; }
+
+  /// read the primitive branches of the main tree a basket at a time
+  /*!
+   *  By default a primitive branch (e.g. weight_mc, met_met) is read
+   *  one entry at a time by a TTreeReaderValue. With this setting
+   *  (which must be enabled before the algorithm is initialized,
+   *  e.g. in its constructor) the branches which support ROOT's
+   *  bulk API are read with a TL::BulkColumn instead: a whole basket
+   *  is deserialized at once and the accessors index into it. The
+   *  other primitive branches keep their TTreeReaderValue.
+   */
+  void enableBulkBranchAccess() { m_bulkBranchAccess = true; }
+
+  /// check if the primitive branches are read in bulk
+  bool bulkBranchAccess() const { return m_bulkBranchAccess; }
+
+  /// connect the branches of the main tree when they are first used
+  /*!
+   *  By default every branch of the main tree known to TopLoop is
+   *  connected to the reader when the algorithm is initialized, and
+   *  the reader services all of them on every entry. With this
+   *  setting (which must be enabled before the algorithm is
+   *  initialized, e.g. in its constructor) a branch is only
+   *  connected the first time its accessor is called, so the reader
+   *  only loads the branches the algorithm actually uses. Connecting
+   *  a branch during the loop restarts the reader and sets it back
+   *  to the current entry.
+   */
+  void enableLazyBranchConnection() { m_lazyBranchConnection = true; }
+
+  /// check if the branches of the main tree are connected on first use
+  bool lazyBranchConnection() const { return m_lazyBranchConnection; }
+
+  /// check if a tree has a (top level) branch
+  /*!
+   *  The names of the branches are indexed in a hash set the first
+   *  time a tree is queried (and again when a chain moves to another
+   *  of its trees), instead of scanning the list of branches for
+   *  every name. The index is dropped whenever the job gives the
+   *  reader another tree.
+   */
+  bool hasBranch(TTree* tree, const char* name) const {
+    if (tree == nullptr) {
+      return false;
+    }
+    // a tree given to the reader may reuse the address of a deleted one
+    if (m_branchIndexTreeChanges != m_readerTreeChanges) {
+      m_branchIndex.clear();
+      m_branchIndexTreeChanges = m_readerTreeChanges;
+    }
+    auto& index = m_branchIndex[tree];
+    const Int_t treeNumber = tree->GetTreeNumber();
+    if (not index.built || index.treeNumber != treeNumber) {
+      const TObjArray* branches = tree->GetListOfBranches();
+      if (branches == nullptr) {
+        return false;
+      }
+      index.names.clear();
+      index.names.reserve(branches->GetEntriesFast());
+      for (const TObject* branch : *branches) {
+        index.names.emplace(branch->GetName());
+      }
+      index.treeNumber = treeNumber;
+      index.built = true;
+    }
+    return index.names.count(name) > 0;
+  }
+
   /// Set up a variable as a TTreeReaderValue pointer
   /*!
    *  This one liner checks to make sure that the variable is on the
    *  tree. If its not - you get a warning. If the variable isn't
    *  there your program will still work as long as you don't try to
-   *  dereference the pointer.
+   *  dereference the pointer. The names of the connected branches
+   *  are recorded, TL::Job::enableBranchAutoPrune keeps them.
    */
   template <typename T>
   std::unique_ptr<T> setupBranch(std::shared_ptr<TTreeReader> reader,
@@ -120,7 +348,8 @@ class Variables {
           name, reader->GetTree()->GetName());
       return nullptr;
     }
-    if (reader->GetTree()->GetListOfBranches()->FindObject(name) != nullptr) {
+    if (hasBranch(reader->GetTree(), name)) {
+      m_connectedBranches.emplace(name);
       return std::make_unique<T>(*reader, name);
     }
     else {
@@ -134,6 +363,127 @@ class Variables {
 
  private:
   std::shared_ptr<spdlog::logger> m_brlogger{nullptr};
+  bool m_arrayBranchAccess{false};
+  bool m_bulkBranchAccess{false};
+  bool m_lazyBranchConnection{false};
+  /// the names of the branches of a tree (see hasBranch)
+  struct BranchIndex {
+    bool built{false};
+    Int_t treeNumber{-1};
+    std::unordered_set<std::string> names{};
+  };
+  mutable std::unordered_map<const TTree*, BranchIndex> m_branchIndex;
+  mutable std::size_t m_branchIndexTreeChanges{0};
+
+ protected:
+  /// a view of the elements read by a TTreeReaderArray
+  template <typename T>
+  static TL::ArrayView<T> viewArray(TTreeReaderArray<T>& array) {
+    // the elements of a std::vector branch are contiguous
+    const std::size_t n = array.GetSize();
+    return {n > 0 ? &array.At(0) : nullptr, n};
+  }
+
+  /// copy the elements read by a TTreeReaderArray to a (reused) vector
+  template <typename T>
+  static const std::vector<T>& copyArray(TTreeReaderArray<T>& array,
+                                         std::vector<T>& copy) {
+    auto view = viewArray(array);
+    copy.assign(view.begin(), view.end());
+    return copy;
+  }
+
+  /// pending particle level entry (see TL::Job::enableLazyParticleLevel)
+  std::shared_ptr<TL::LazyEntry> m_lazyParticleLevel{std::make_shared<TL::LazyEntry>()};
+  /// pending truth entry (see TL::Job::enableLazyParticleLevel)
+  std::shared_ptr<TL::LazyEntry> m_lazyTruth{std::make_shared<TL::LazyEntry>()};
+
+  /// set the particle level reader to the current event
+  /*!
+   *  Only needed before using TTreeReaderValues connected by hand to
+   *  particleLevelReader() when the job positions the particle level
+   *  reader lazily; the PL_* accessors do it themselves.
+   */
+  void loadParticleLevelEntry() const { m_lazyParticleLevel->load(); }
+  /// set the truth reader to the current event (see loadParticleLevelEntry)
+  void loadTruthEntry() const { m_lazyTruth->load(); }
+
+  /// reader which branches are connected to on first use (if any)
+  std::shared_ptr<TTreeReader> m_lazyReader{nullptr};
+  /// called with the reader's tree after connectLazily restarted the reader
+  std::function<void(TTree*)> m_lazyReaderRestarted{};
+
+  /// number of times the job gave the main reader another tree (see TL::BulkColumn)
+  std::size_t m_readerTreeChanges{0};
+
+  /// names of the branches connected to a reader so far (see setupBranch)
+  mutable std::set<std::string> m_connectedBranches{};
+  /// disabled branches enabled again on their first use (see TL::Job)
+  mutable std::vector<std::string> m_reenabledBranches{};
+
+  /// accessors of the connected float branches, by branch name (see TL::WeightTool)
+  std::map<std::string, Float_t (Variables::*)() const> m_floatAccessors{};
+  /// accessors of the connected std::vector<float> branches, by branch name
+  std::map<std::string, const std::vector<float>& (Variables::*)() const>
+      m_floatVectorAccessors{};
+
+  /// record the accessor of a connected branch (only float and vector<float> are kept)
+  template <typename R>
+  void registerAccessor(const char*, R (Variables::*)() const) {}
+  /// record the accessor of a connected float branch
+  void registerAccessor(const char* name, Float_t (Variables::*accessor)() const) {
+    m_floatAccessors.emplace(name, accessor);
+  }
+  /// record the accessor of a connected std::vector<float> branch
+  void registerAccessor(const char* name,
+                        const std::vector<float>& (Variables::*accessor)() const) {
+    m_floatVectorAccessors.emplace(name, accessor);
+  }
+
+  /// check if connecting a branch to a reader is left to its first use
+  bool deferBranch(const std::shared_ptr<TTreeReader>& reader) const {
+    return m_lazyReader != nullptr && reader == m_lazyReader;
+  }
+
+  /// connect a branch on the first call of its accessor
+  /*!
+   *  Returns false if the branch was already tried (or lazy
+   *  connection is disabled). A branch disabled in the meantime
+   *  (e.g. pruned by TL::Job) is enabled again first. TTreeReader
+   *  only accepts new values before it loads an entry, so if it is
+   *  positioned the reader is restarted and set back to the same
+   *  entry, which also reads the new branch. The restart resets the
+   *  branches of the tree's cache, m_lazyReaderRestarted sets them
+   *  up again.
+   */
+  template <typename F>
+  bool connectLazily(bool& tried, const char* name, F&& connect) const {
+    if (tried || m_lazyReader == nullptr) {
+      return false;
+    }
+    tried = true;
+    TTree* tree = m_lazyReader->GetTree();
+    if (hasBranch(tree, name)) {
+      if (not tree->GetBranchStatus(name)) {
+        m_brlogger->warn("{} branch was disabled, enabling it again", name);
+        tree->SetBranchStatus(name, 1);
+        tree->AddBranchToCache(name, true);
+        m_reenabledBranches.emplace_back(name);
+      }
+    }
+    const Long64_t entry = m_lazyReader->GetCurrentEntry();
+    if (entry >= 0) {
+      m_lazyReader->Restart();
+    }
+    connect();
+    if (entry >= 0) {
+      m_lazyReader->SetEntry(entry);
+      if (m_lazyReaderRestarted) {
+        m_lazyReaderRestarted(m_lazyReader->GetTree());
+      }
+    }
+    return true;
+  }
 
  protected:
   std::unique_ptr<TTreeReaderValue<Int_t>> bv__dsid;
@@ -158,14 +508,14 @@ class Variables {
   DECLARE_BRANCH(totalEventsWeighted_mc_generator_weights, std::vector<float>);
   DECLARE_BRANCH(names_mc_generator_weights, std::vector<std::string>);
 
-  DECLARE_BRANCH(PDFinfo_X1, std::vector<float>);
-  DECLARE_BRANCH(PDFinfo_X2, std::vector<float>);
-  DECLARE_BRANCH(PDFinfo_PDGID1, std::vector<int>);
-  DECLARE_BRANCH(PDFinfo_PDGID2, std::vector<int>);
-  DECLARE_BRANCH(PDFinfo_Q, std::vector<float>);
-  DECLARE_BRANCH(PDFinfo_XF1, std::vector<float>);
-  DECLARE_BRANCH(PDFinfo_XF2, std::vector<float>);
-  DECLARE_BRANCH(mc_generator_weights, std::vector<float>);
+  DECLARE_VECTOR_BRANCH(PDFinfo_X1, float);
+  DECLARE_VECTOR_BRANCH(PDFinfo_X2, float);
+  DECLARE_VECTOR_BRANCH(PDFinfo_PDGID1, int);
+  DECLARE_VECTOR_BRANCH(PDFinfo_PDGID2, int);
+  DECLARE_VECTOR_BRANCH(PDFinfo_Q, float);
+  DECLARE_VECTOR_BRANCH(PDFinfo_XF1, float);
+  DECLARE_VECTOR_BRANCH(PDFinfo_XF2, float);
+  DECLARE_VECTOR_BRANCH(mc_generator_weights, float);
   DECLARE_BRANCH_PRIMITIVE(weight_mc, Float_t);
   DECLARE_BRANCH_PRIMITIVE(weight_pileup, Float_t);
   DECLARE_BRANCH_PRIMITIVE(weight_leptonSF, Float_t);
@@ -261,80 +611,80 @@ class Variables {
   DECLARE_BRANCH_PRIMITIVE(weight_jvt_DOWN, Float_t);
   DECLARE_BRANCH_PRIMITIVE(weight_forwardjvt_UP, Float_t);
   DECLARE_BRANCH_PRIMITIVE(weight_forwardjvt_DOWN, Float_t);
-  DECLARE_BRANCH(weight_bTagSF_MV2c10_77_eigenvars_B_up, std::vector<float>);
-  DECLARE_BRANCH(weight_bTagSF_MV2c10_77_eigenvars_C_up, std::vector<float>);
-  DECLARE_BRANCH(weight_bTagSF_MV2c10_77_eigenvars_Light_up, std::vector<float>);
-  DECLARE_BRANCH(weight_bTagSF_MV2c10_77_eigenvars_B_down, std::vector<float>);
-  DECLARE_BRANCH(weight_bTagSF_MV2c10_77_eigenvars_C_down, std::vector<float>);
-  DECLARE_BRANCH(weight_bTagSF_MV2c10_77_eigenvars_Light_down, std::vector<float>);
+  DECLARE_VECTOR_BRANCH(weight_bTagSF_MV2c10_77_eigenvars_B_up, float);
+  DECLARE_VECTOR_BRANCH(weight_bTagSF_MV2c10_77_eigenvars_C_up, float);
+  DECLARE_VECTOR_BRANCH(weight_bTagSF_MV2c10_77_eigenvars_Light_up, float);
+  DECLARE_VECTOR_BRANCH(weight_bTagSF_MV2c10_77_eigenvars_B_down, float);
+  DECLARE_VECTOR_BRANCH(weight_bTagSF_MV2c10_77_eigenvars_C_down, float);
+  DECLARE_VECTOR_BRANCH(weight_bTagSF_MV2c10_77_eigenvars_Light_down, float);
   DECLARE_BRANCH_PRIMITIVE(weight_bTagSF_MV2c10_77_extrapolation_up, Float_t);
   DECLARE_BRANCH_PRIMITIVE(weight_bTagSF_MV2c10_77_extrapolation_down, Float_t);
   DECLARE_BRANCH_PRIMITIVE(weight_bTagSF_MV2c10_77_extrapolation_from_charm_up, Float_t);
   DECLARE_BRANCH_PRIMITIVE(weight_bTagSF_MV2c10_77_extrapolation_from_charm_down, Float_t);
-  DECLARE_BRANCH(weight_bTagSF_MV2c10_Continuous_eigenvars_B_up, std::vector<float>);
-  DECLARE_BRANCH(weight_bTagSF_MV2c10_Continuous_eigenvars_C_up, std::vector<float>);
-  DECLARE_BRANCH(weight_bTagSF_MV2c10_Continuous_eigenvars_Light_up, std::vector<float>);
-  DECLARE_BRANCH(weight_bTagSF_MV2c10_Continuous_eigenvars_B_down, std::vector<float>);
-  DECLARE_BRANCH(weight_bTagSF_MV2c10_Continuous_eigenvars_C_down, std::vector<float>);
-  DECLARE_BRANCH(weight_bTagSF_MV2c10_Continuous_eigenvars_Light_down, std::vector<float>);
-  DECLARE_BRANCH(weight_bTagSF_DL1_HybBEff_60_eigenvars_B_up, std::vector<float>);
-  DECLARE_BRANCH(weight_bTagSF_DL1_HybBEff_60_eigenvars_C_up, std::vector<float>);
-  DECLARE_BRANCH(weight_bTagSF_DL1_HybBEff_60_eigenvars_Light_up, std::vector<float>);
-  DECLARE_BRANCH(weight_bTagSF_DL1_HybBEff_60_eigenvars_B_down, std::vector<float>);
-  DECLARE_BRANCH(weight_bTagSF_DL1_HybBEff_60_eigenvars_C_down, std::vector<float>);
-  DECLARE_BRANCH(weight_bTagSF_DL1_HybBEff_60_eigenvars_Light_down, std::vector<float>);
+  DECLARE_VECTOR_BRANCH(weight_bTagSF_MV2c10_Continuous_eigenvars_B_up, float);
+  DECLARE_VECTOR_BRANCH(weight_bTagSF_MV2c10_Continuous_eigenvars_C_up, float);
+  DECLARE_VECTOR_BRANCH(weight_bTagSF_MV2c10_Continuous_eigenvars_Light_up, float);
+  DECLARE_VECTOR_BRANCH(weight_bTagSF_MV2c10_Continuous_eigenvars_B_down, float);
+  DECLARE_VECTOR_BRANCH(weight_bTagSF_MV2c10_Continuous_eigenvars_C_down, float);
+  DECLARE_VECTOR_BRANCH(weight_bTagSF_MV2c10_Continuous_eigenvars_Light_down, float);
+  DECLARE_VECTOR_BRANCH(weight_bTagSF_DL1_HybBEff_60_eigenvars_B_up, float);
+  DECLARE_VECTOR_BRANCH(weight_bTagSF_DL1_HybBEff_60_eigenvars_C_up, float);
+  DECLARE_VECTOR_BRANCH(weight_bTagSF_DL1_HybBEff_60_eigenvars_Light_up, float);
+  DECLARE_VECTOR_BRANCH(weight_bTagSF_DL1_HybBEff_60_eigenvars_B_down, float);
+  DECLARE_VECTOR_BRANCH(weight_bTagSF_DL1_HybBEff_60_eigenvars_C_down, float);
+  DECLARE_VECTOR_BRANCH(weight_bTagSF_DL1_HybBEff_60_eigenvars_Light_down, float);
   DECLARE_BRANCH_PRIMITIVE(weight_bTagSF_DL1_HybBEff_60_extrapolation_up, Float_t);
   DECLARE_BRANCH_PRIMITIVE(weight_bTagSF_DL1_HybBEff_60_extrapolation_down, Float_t);
   DECLARE_BRANCH_PRIMITIVE(weight_bTagSF_DL1_HybBEff_60_extrapolation_from_charm_up,
                            Float_t);
   DECLARE_BRANCH_PRIMITIVE(weight_bTagSF_DL1_HybBEff_60_extrapolation_from_charm_down,
                            Float_t);
-  DECLARE_BRANCH(weight_bTagSF_DL1r_85_eigenvars_B_up, std::vector<float>);
-  DECLARE_BRANCH(weight_bTagSF_DL1r_85_eigenvars_C_up, std::vector<float>);
-  DECLARE_BRANCH(weight_bTagSF_DL1r_85_eigenvars_Light_up, std::vector<float>);
-  DECLARE_BRANCH(weight_bTagSF_DL1r_85_eigenvars_B_down, std::vector<float>);
-  DECLARE_BRANCH(weight_bTagSF_DL1r_85_eigenvars_C_down, std::vector<float>);
-  DECLARE_BRANCH(weight_bTagSF_DL1r_85_eigenvars_Light_down, std::vector<float>);
+  DECLARE_VECTOR_BRANCH(weight_bTagSF_DL1r_85_eigenvars_B_up, float);
+  DECLARE_VECTOR_BRANCH(weight_bTagSF_DL1r_85_eigenvars_C_up, float);
+  DECLARE_VECTOR_BRANCH(weight_bTagSF_DL1r_85_eigenvars_Light_up, float);
+  DECLARE_VECTOR_BRANCH(weight_bTagSF_DL1r_85_eigenvars_B_down, float);
+  DECLARE_VECTOR_BRANCH(weight_bTagSF_DL1r_85_eigenvars_C_down, float);
+  DECLARE_VECTOR_BRANCH(weight_bTagSF_DL1r_85_eigenvars_Light_down, float);
   DECLARE_BRANCH_PRIMITIVE(weight_bTagSF_DL1r_85_extrapolation_up, Float_t);
   DECLARE_BRANCH_PRIMITIVE(weight_bTagSF_DL1r_85_extrapolation_down, Float_t);
   DECLARE_BRANCH_PRIMITIVE(weight_bTagSF_DL1r_85_extrapolation_from_charm_up, Float_t);
   DECLARE_BRANCH_PRIMITIVE(weight_bTagSF_DL1r_85_extrapolation_from_charm_down, Float_t);
-  DECLARE_BRANCH(weight_bTagSF_DL1r_77_eigenvars_B_up, std::vector<float>);
-  DECLARE_BRANCH(weight_bTagSF_DL1r_77_eigenvars_C_up, std::vector<float>);
-  DECLARE_BRANCH(weight_bTagSF_DL1r_77_eigenvars_Light_up, std::vector<float>);
-  DECLARE_BRANCH(weight_bTagSF_DL1r_77_eigenvars_B_down, std::vector<float>);
-  DECLARE_BRANCH(weight_bTagSF_DL1r_77_eigenvars_C_down, std::vector<float>);
-  DECLARE_BRANCH(weight_bTagSF_DL1r_77_eigenvars_Light_down, std::vector<float>);
+  DECLARE_VECTOR_BRANCH(weight_bTagSF_DL1r_77_eigenvars_B_up, float);
+  DECLARE_VECTOR_BRANCH(weight_bTagSF_DL1r_77_eigenvars_C_up, float);
+  DECLARE_VECTOR_BRANCH(weight_bTagSF_DL1r_77_eigenvars_Light_up, float);
+  DECLARE_VECTOR_BRANCH(weight_bTagSF_DL1r_77_eigenvars_B_down, float);
+  DECLARE_VECTOR_BRANCH(weight_bTagSF_DL1r_77_eigenvars_C_down, float);
+  DECLARE_VECTOR_BRANCH(weight_bTagSF_DL1r_77_eigenvars_Light_down, float);
   DECLARE_BRANCH_PRIMITIVE(weight_bTagSF_DL1r_77_extrapolation_up, Float_t);
   DECLARE_BRANCH_PRIMITIVE(weight_bTagSF_DL1r_77_extrapolation_down, Float_t);
   DECLARE_BRANCH_PRIMITIVE(weight_bTagSF_DL1r_77_extrapolation_from_charm_up, Float_t);
   DECLARE_BRANCH_PRIMITIVE(weight_bTagSF_DL1r_77_extrapolation_from_charm_down, Float_t);
-  DECLARE_BRANCH(weight_bTagSF_DL1r_70_eigenvars_B_up, std::vector<float>);
-  DECLARE_BRANCH(weight_bTagSF_DL1r_70_eigenvars_C_up, std::vector<float>);
-  DECLARE_BRANCH(weight_bTagSF_DL1r_70_eigenvars_Light_up, std::vector<float>);
-  DECLARE_BRANCH(weight_bTagSF_DL1r_70_eigenvars_B_down, std::vector<float>);
-  DECLARE_BRANCH(weight_bTagSF_DL1r_70_eigenvars_C_down, std::vector<float>);
-  DECLARE_BRANCH(weight_bTagSF_DL1r_70_eigenvars_Light_down, std::vector<float>);
+  DECLARE_VECTOR_BRANCH(weight_bTagSF_DL1r_70_eigenvars_B_up, float);
+  DECLARE_VECTOR_BRANCH(weight_bTagSF_DL1r_70_eigenvars_C_up, float);
+  DECLARE_VECTOR_BRANCH(weight_bTagSF_DL1r_70_eigenvars_Light_up, float);
+  DECLARE_VECTOR_BRANCH(weight_bTagSF_DL1r_70_eigenvars_B_down, float);
+  DECLARE_VECTOR_BRANCH(weight_bTagSF_DL1r_70_eigenvars_C_down, float);
+  DECLARE_VECTOR_BRANCH(weight_bTagSF_DL1r_70_eigenvars_Light_down, float);
   DECLARE_BRANCH_PRIMITIVE(weight_bTagSF_DL1r_70_extrapolation_up, Float_t);
   DECLARE_BRANCH_PRIMITIVE(weight_bTagSF_DL1r_70_extrapolation_down, Float_t);
   DECLARE_BRANCH_PRIMITIVE(weight_bTagSF_DL1r_70_extrapolation_from_charm_up, Float_t);
   DECLARE_BRANCH_PRIMITIVE(weight_bTagSF_DL1r_70_extrapolation_from_charm_down, Float_t);
-  DECLARE_BRANCH(weight_bTagSF_DL1r_60_eigenvars_B_up, std::vector<float>);
-  DECLARE_BRANCH(weight_bTagSF_DL1r_60_eigenvars_C_up, std::vector<float>);
-  DECLARE_BRANCH(weight_bTagSF_DL1r_60_eigenvars_Light_up, std::vector<float>);
-  DECLARE_BRANCH(weight_bTagSF_DL1r_60_eigenvars_B_down, std::vector<float>);
-  DECLARE_BRANCH(weight_bTagSF_DL1r_60_eigenvars_C_down, std::vector<float>);
-  DECLARE_BRANCH(weight_bTagSF_DL1r_60_eigenvars_Light_down, std::vector<float>);
+  DECLARE_VECTOR_BRANCH(weight_bTagSF_DL1r_60_eigenvars_B_up, float);
+  DECLARE_VECTOR_BRANCH(weight_bTagSF_DL1r_60_eigenvars_C_up, float);
+  DECLARE_VECTOR_BRANCH(weight_bTagSF_DL1r_60_eigenvars_Light_up, float);
+  DECLARE_VECTOR_BRANCH(weight_bTagSF_DL1r_60_eigenvars_B_down, float);
+  DECLARE_VECTOR_BRANCH(weight_bTagSF_DL1r_60_eigenvars_C_down, float);
+  DECLARE_VECTOR_BRANCH(weight_bTagSF_DL1r_60_eigenvars_Light_down, float);
   DECLARE_BRANCH_PRIMITIVE(weight_bTagSF_DL1r_60_extrapolation_up, Float_t);
   DECLARE_BRANCH_PRIMITIVE(weight_bTagSF_DL1r_60_extrapolation_down, Float_t);
   DECLARE_BRANCH_PRIMITIVE(weight_bTagSF_DL1r_60_extrapolation_from_charm_up, Float_t);
   DECLARE_BRANCH_PRIMITIVE(weight_bTagSF_DL1r_60_extrapolation_from_charm_down, Float_t);
-  DECLARE_BRANCH(weight_bTagSF_DL1r_Continuous_eigenvars_B_up, std::vector<float>);
-  DECLARE_BRANCH(weight_bTagSF_DL1r_Continuous_eigenvars_C_up, std::vector<float>);
-  DECLARE_BRANCH(weight_bTagSF_DL1r_Continuous_eigenvars_Light_up, std::vector<float>);
-  DECLARE_BRANCH(weight_bTagSF_DL1r_Continuous_eigenvars_B_down, std::vector<float>);
-  DECLARE_BRANCH(weight_bTagSF_DL1r_Continuous_eigenvars_C_down, std::vector<float>);
-  DECLARE_BRANCH(weight_bTagSF_DL1r_Continuous_eigenvars_Light_down, std::vector<float>);
+  DECLARE_VECTOR_BRANCH(weight_bTagSF_DL1r_Continuous_eigenvars_B_up, float);
+  DECLARE_VECTOR_BRANCH(weight_bTagSF_DL1r_Continuous_eigenvars_C_up, float);
+  DECLARE_VECTOR_BRANCH(weight_bTagSF_DL1r_Continuous_eigenvars_Light_up, float);
+  DECLARE_VECTOR_BRANCH(weight_bTagSF_DL1r_Continuous_eigenvars_B_down, float);
+  DECLARE_VECTOR_BRANCH(weight_bTagSF_DL1r_Continuous_eigenvars_C_down, float);
+  DECLARE_VECTOR_BRANCH(weight_bTagSF_DL1r_Continuous_eigenvars_Light_down, float);
   DECLARE_BRANCH_PRIMITIVE(eventNumber, ULong64_t);
   DECLARE_BRANCH_PRIMITIVE(runNumber, UInt_t);
   DECLARE_BRANCH_PRIMITIVE(randomRunNumber, UInt_t);
@@ -342,103 +692,103 @@ class Variables {
   DECLARE_BRANCH_PRIMITIVE(mu, Float_t);
   DECLARE_BRANCH_PRIMITIVE(backgroundFlags, UInt_t);
   DECLARE_BRANCH_PRIMITIVE(hasBadMuon, UInt_t);
-  DECLARE_BRANCH(el_pt, std::vector<float>);
-  DECLARE_BRANCH(el_eta, std::vector<float>);
-  DECLARE_BRANCH(el_cl_eta, std::vector<float>);
-  DECLARE_BRANCH(el_phi, std::vector<float>);
-  DECLARE_BRANCH(el_e, std::vector<float>);
-  DECLARE_BRANCH(el_charge, std::vector<float>);
-  DECLARE_BRANCH(el_topoetcone20, std::vector<float>);
-  DECLARE_BRANCH(el_ptvarcone20, std::vector<float>);
-  DECLARE_BRANCH(el_isTight, std::vector<char>);
-  DECLARE_BRANCH(el_Isol_Gradient, std::vector<char>);
-  DECLARE_BRANCH(el_Isol_FCLoose, std::vector<char>);
-  DECLARE_BRANCH(el_Isol_FCTight, std::vector<char>);
-  DECLARE_BRANCH(el_Isol_FCHighPtCaloOnly, std::vector<char>);
-  DECLARE_BRANCH(el_Isol_HighPtCaloOnly, std::vector<char>);
-  DECLARE_BRANCH(el_Isol_Loose, std::vector<char>);
-  DECLARE_BRANCH(el_Isol_Tight, std::vector<char>);
-  DECLARE_BRANCH(el_Isol_TightTrackOnly, std::vector<char>);
-  DECLARE_BRANCH(el_Isol_TightTrackOnly_FixedRad, std::vector<char>);
-  DECLARE_BRANCH(el_Isol_PLVTight, std::vector<char>);
-  DECLARE_BRANCH(el_Isol_PLVLoose, std::vector<char>);
-  DECLARE_BRANCH(el_Isol_PflowTight, std::vector<char>);
-  DECLARE_BRANCH(el_Isol_PflowLoose, std::vector<char>);
-  DECLARE_BRANCH(el_CF, std::vector<char>);
-  DECLARE_BRANCH(el_ECIDS, std::vector<char>);
-  DECLARE_BRANCH(el_ECIDSResult, std::vector<float>);
-  DECLARE_BRANCH(el_d0sig, std::vector<float>);
-  DECLARE_BRANCH(el_delta_z0_sintheta, std::vector<float>);
-  DECLARE_BRANCH(el_true_type, std::vector<int>);
-  DECLARE_BRANCH(el_true_origin, std::vector<int>);
-  DECLARE_BRANCH(el_true_originbkg, std::vector<int>);
-  DECLARE_BRANCH(el_true_typebkg, std::vector<int>);
-  DECLARE_BRANCH(el_true_firstEgMotherTruthType, std::vector<int>);
-  DECLARE_BRANCH(el_true_firstEgMotherTruthOrigin, std::vector<int>);
-  DECLARE_BRANCH(el_true_firstEgMotherPdgId, std::vector<int>);
-  DECLARE_BRANCH(el_true_isPrompt, std::vector<char>);
-  DECLARE_BRANCH(el_true_isChargeFl, std::vector<char>);
-  DECLARE_BRANCH(mu_pt, std::vector<float>);
-  DECLARE_BRANCH(mu_eta, std::vector<float>);
-  DECLARE_BRANCH(mu_phi, std::vector<float>);
-  DECLARE_BRANCH(mu_e, std::vector<float>);
-  DECLARE_BRANCH(mu_charge, std::vector<float>);
-  DECLARE_BRANCH(mu_topoetcone20, std::vector<float>);
-  DECLARE_BRANCH(mu_ptvarcone30, std::vector<float>);
-  DECLARE_BRANCH(mu_isTight, std::vector<char>);
-  DECLARE_BRANCH(mu_Isol_FCTight, std::vector<char>);
-  DECLARE_BRANCH(mu_Isol_FCLoose, std::vector<char>);
-  DECLARE_BRANCH(mu_Isol_FCTightTrackOnly, std::vector<char>);
-  DECLARE_BRANCH(mu_Isol_FCTightTrackOnly_FixedRad, std::vector<char>);
-  DECLARE_BRANCH(mu_Isol_FCLoose_FixedRad, std::vector<char>);
-  DECLARE_BRANCH(mu_Isol_FCTight_FixedRad, std::vector<char>);
-  DECLARE_BRANCH(mu_Isol_FixedCutPflowTight, std::vector<char>);
-  DECLARE_BRANCH(mu_Isol_FixedCutPflowLoose, std::vector<char>);
-  DECLARE_BRANCH(mu_d0sig, std::vector<float>);
-  DECLARE_BRANCH(mu_delta_z0_sintheta, std::vector<float>);
-  DECLARE_BRANCH(mu_true_type, std::vector<int>);
-  DECLARE_BRANCH(mu_true_origin, std::vector<int>);
-  DECLARE_BRANCH(mu_true_isPrompt, std::vector<char>);
-  DECLARE_BRANCH(tau_pt, std::vector<float>);
-  DECLARE_BRANCH(tau_eta, std::vector<float>);
-  DECLARE_BRANCH(tau_phi, std::vector<float>);
-  DECLARE_BRANCH(tau_charge, std::vector<float>);
-  DECLARE_BRANCH(tau_nTrack, std::vector<float>);
-  DECLARE_BRANCH(tau_true_pdg, std::vector<int>);
-  DECLARE_BRANCH(tau_true_pt, std::vector<float>);
-  DECLARE_BRANCH(tau_true_eta, std::vector<float>);
-  DECLARE_BRANCH(tau_tight, std::vector<float>);
-  DECLARE_BRANCH(tau_RNNScore, std::vector<float>);
-  DECLARE_BRANCH(tau_BDTScore, std::vector<float>);
-  DECLARE_BRANCH(jet_pt, std::vector<float>);
-  DECLARE_BRANCH(jet_eta, std::vector<float>);
-  DECLARE_BRANCH(jet_phi, std::vector<float>);
-  DECLARE_BRANCH(jet_e, std::vector<float>);
-  DECLARE_BRANCH(jet_mv2c00, std::vector<float>);
-  DECLARE_BRANCH(jet_mv2c10, std::vector<float>);
-  DECLARE_BRANCH(jet_mv2c20, std::vector<float>);
-  DECLARE_BRANCH(jet_forwardjvt, std::vector<float>);
-  DECLARE_BRANCH(jet_passfjvt, std::vector<char>); // supersede by jet_passforwardjvt
-  DECLARE_BRANCH(jet_passforwardjvt, std::vector<char>);
-  DECLARE_BRANCH(jet_truthflav, std::vector<int>);
-  DECLARE_BRANCH(jet_truthPartonLabel, std::vector<int>);
-  DECLARE_BRANCH(jet_isTrueHS, std::vector<char>);
-  DECLARE_BRANCH(jet_isbtagged_MV2c10_70, std::vector<char>);
-  DECLARE_BRANCH(jet_isbtagged_MV2c10_77, std::vector<char>);
-  DECLARE_BRANCH(jet_isbtagged_MV2c10_85, std::vector<char>);
-  DECLARE_BRANCH(jet_tagWeightBin_MV2c10_Continuous, std::vector<int>);
-  DECLARE_BRANCH(jet_isbtagged_DL1_HybBEff_60, std::vector<char>);
-  DECLARE_BRANCH(jet_truthflavExtended, std::vector<int>);
-  DECLARE_BRANCH(jet_isbtagged_DL1r_60, std::vector<char>);
-  DECLARE_BRANCH(jet_isbtagged_DL1r_70, std::vector<char>);
-  DECLARE_BRANCH(jet_isbtagged_DL1r_77, std::vector<char>);
-  DECLARE_BRANCH(jet_isbtagged_DL1r_85, std::vector<char>);
-  DECLARE_BRANCH(jet_tagWeightBin_DL1r_Continuous, std::vector<int>);
-  DECLARE_BRANCH(jet_MV2c10mu, std::vector<float>);
-  DECLARE_BRANCH(jet_MV2c10rnn, std::vector<float>);
-  DECLARE_BRANCH(jet_DL1, std::vector<float>);
-  DECLARE_BRANCH(jet_DL1r, std::vector<float>);
-  DECLARE_BRANCH(jet_DL1rmu, std::vector<float>);
+  DECLARE_VECTOR_BRANCH(el_pt, float);
+  DECLARE_VECTOR_BRANCH(el_eta, float);
+  DECLARE_VECTOR_BRANCH(el_cl_eta, float);
+  DECLARE_VECTOR_BRANCH(el_phi, float);
+  DECLARE_VECTOR_BRANCH(el_e, float);
+  DECLARE_VECTOR_BRANCH(el_charge, float);
+  DECLARE_VECTOR_BRANCH(el_topoetcone20, float);
+  DECLARE_VECTOR_BRANCH(el_ptvarcone20, float);
+  DECLARE_VECTOR_BRANCH(el_isTight, char);
+  DECLARE_VECTOR_BRANCH(el_Isol_Gradient, char);
+  DECLARE_VECTOR_BRANCH(el_Isol_FCLoose, char);
+  DECLARE_VECTOR_BRANCH(el_Isol_FCTight, char);
+  DECLARE_VECTOR_BRANCH(el_Isol_FCHighPtCaloOnly, char);
+  DECLARE_VECTOR_BRANCH(el_Isol_HighPtCaloOnly, char);
+  DECLARE_VECTOR_BRANCH(el_Isol_Loose, char);
+  DECLARE_VECTOR_BRANCH(el_Isol_Tight, char);
+  DECLARE_VECTOR_BRANCH(el_Isol_TightTrackOnly, char);
+  DECLARE_VECTOR_BRANCH(el_Isol_TightTrackOnly_FixedRad, char);
+  DECLARE_VECTOR_BRANCH(el_Isol_PLVTight, char);
+  DECLARE_VECTOR_BRANCH(el_Isol_PLVLoose, char);
+  DECLARE_VECTOR_BRANCH(el_Isol_PflowTight, char);
+  DECLARE_VECTOR_BRANCH(el_Isol_PflowLoose, char);
+  DECLARE_VECTOR_BRANCH(el_CF, char);
+  DECLARE_VECTOR_BRANCH(el_ECIDS, char);
+  DECLARE_VECTOR_BRANCH(el_ECIDSResult, float);
+  DECLARE_VECTOR_BRANCH(el_d0sig, float);
+  DECLARE_VECTOR_BRANCH(el_delta_z0_sintheta, float);
+  DECLARE_VECTOR_BRANCH(el_true_type, int);
+  DECLARE_VECTOR_BRANCH(el_true_origin, int);
+  DECLARE_VECTOR_BRANCH(el_true_originbkg, int);
+  DECLARE_VECTOR_BRANCH(el_true_typebkg, int);
+  DECLARE_VECTOR_BRANCH(el_true_firstEgMotherTruthType, int);
+  DECLARE_VECTOR_BRANCH(el_true_firstEgMotherTruthOrigin, int);
+  DECLARE_VECTOR_BRANCH(el_true_firstEgMotherPdgId, int);
+  DECLARE_VECTOR_BRANCH(el_true_isPrompt, char);
+  DECLARE_VECTOR_BRANCH(el_true_isChargeFl, char);
+  DECLARE_VECTOR_BRANCH(mu_pt, float);
+  DECLARE_VECTOR_BRANCH(mu_eta, float);
+  DECLARE_VECTOR_BRANCH(mu_phi, float);
+  DECLARE_VECTOR_BRANCH(mu_e, float);
+  DECLARE_VECTOR_BRANCH(mu_charge, float);
+  DECLARE_VECTOR_BRANCH(mu_topoetcone20, float);
+  DECLARE_VECTOR_BRANCH(mu_ptvarcone30, float);
+  DECLARE_VECTOR_BRANCH(mu_isTight, char);
+  DECLARE_VECTOR_BRANCH(mu_Isol_FCTight, char);
+  DECLARE_VECTOR_BRANCH(mu_Isol_FCLoose, char);
+  DECLARE_VECTOR_BRANCH(mu_Isol_FCTightTrackOnly, char);
+  DECLARE_VECTOR_BRANCH(mu_Isol_FCTightTrackOnly_FixedRad, char);
+  DECLARE_VECTOR_BRANCH(mu_Isol_FCLoose_FixedRad, char);
+  DECLARE_VECTOR_BRANCH(mu_Isol_FCTight_FixedRad, char);
+  DECLARE_VECTOR_BRANCH(mu_Isol_FixedCutPflowTight, char);
+  DECLARE_VECTOR_BRANCH(mu_Isol_FixedCutPflowLoose, char);
+  DECLARE_VECTOR_BRANCH(mu_d0sig, float);
+  DECLARE_VECTOR_BRANCH(mu_delta_z0_sintheta, float);
+  DECLARE_VECTOR_BRANCH(mu_true_type, int);
+  DECLARE_VECTOR_BRANCH(mu_true_origin, int);
+  DECLARE_VECTOR_BRANCH(mu_true_isPrompt, char);
+  DECLARE_VECTOR_BRANCH(tau_pt, float);
+  DECLARE_VECTOR_BRANCH(tau_eta, float);
+  DECLARE_VECTOR_BRANCH(tau_phi, float);
+  DECLARE_VECTOR_BRANCH(tau_charge, float);
+  DECLARE_VECTOR_BRANCH(tau_nTrack, float);
+  DECLARE_VECTOR_BRANCH(tau_true_pdg, int);
+  DECLARE_VECTOR_BRANCH(tau_true_pt, float);
+  DECLARE_VECTOR_BRANCH(tau_true_eta, float);
+  DECLARE_VECTOR_BRANCH(tau_tight, float);
+  DECLARE_VECTOR_BRANCH(tau_RNNScore, float);
+  DECLARE_VECTOR_BRANCH(tau_BDTScore, float);
+  DECLARE_VECTOR_BRANCH(jet_pt, float);
+  DECLARE_VECTOR_BRANCH(jet_eta, float);
+  DECLARE_VECTOR_BRANCH(jet_phi, float);
+  DECLARE_VECTOR_BRANCH(jet_e, float);
+  DECLARE_VECTOR_BRANCH(jet_mv2c00, float);
+  DECLARE_VECTOR_BRANCH(jet_mv2c10, float);
+  DECLARE_VECTOR_BRANCH(jet_mv2c20, float);
+  DECLARE_VECTOR_BRANCH(jet_forwardjvt, float);
+  DECLARE_VECTOR_BRANCH(jet_passfjvt, char); // supersede by jet_passforwardjvt
+  DECLARE_VECTOR_BRANCH(jet_passforwardjvt, char);
+  DECLARE_VECTOR_BRANCH(jet_truthflav, int);
+  DECLARE_VECTOR_BRANCH(jet_truthPartonLabel, int);
+  DECLARE_VECTOR_BRANCH(jet_isTrueHS, char);
+  DECLARE_VECTOR_BRANCH(jet_isbtagged_MV2c10_70, char);
+  DECLARE_VECTOR_BRANCH(jet_isbtagged_MV2c10_77, char);
+  DECLARE_VECTOR_BRANCH(jet_isbtagged_MV2c10_85, char);
+  DECLARE_VECTOR_BRANCH(jet_tagWeightBin_MV2c10_Continuous, int);
+  DECLARE_VECTOR_BRANCH(jet_isbtagged_DL1_HybBEff_60, char);
+  DECLARE_VECTOR_BRANCH(jet_truthflavExtended, int);
+  DECLARE_VECTOR_BRANCH(jet_isbtagged_DL1r_60, char);
+  DECLARE_VECTOR_BRANCH(jet_isbtagged_DL1r_70, char);
+  DECLARE_VECTOR_BRANCH(jet_isbtagged_DL1r_77, char);
+  DECLARE_VECTOR_BRANCH(jet_isbtagged_DL1r_85, char);
+  DECLARE_VECTOR_BRANCH(jet_tagWeightBin_DL1r_Continuous, int);
+  DECLARE_VECTOR_BRANCH(jet_MV2c10mu, float);
+  DECLARE_VECTOR_BRANCH(jet_MV2c10rnn, float);
+  DECLARE_VECTOR_BRANCH(jet_DL1, float);
+  DECLARE_VECTOR_BRANCH(jet_DL1r, float);
+  DECLARE_VECTOR_BRANCH(jet_DL1rmu, float);
   DECLARE_BRANCH_PRIMITIVE(met_met, Float_t);
   DECLARE_BRANCH_PRIMITIVE(met_phi, Float_t);
   DECLARE_BRANCH_PRIMITIVE(all_particle, Int_t);
@@ -532,46 +882,46 @@ class Variables {
   DECLARE_BRANCH_PRIMITIVE(HLT_2e24_lhvloose_nod0, Char_t);
   DECLARE_BRANCH_PRIMITIVE(HLT_e17_lhloose_nod0_mu14, Char_t);
   DECLARE_BRANCH_PRIMITIVE(HLT_e7_lhmedium_nod0_mu24, Char_t);
-  DECLARE_BRANCH(el_trigMatch_HLT_e60_lhmedium_nod0, std::vector<char>);
-  DECLARE_BRANCH(el_trigMatch_HLT_e120_lhloose, std::vector<char>);
-  DECLARE_BRANCH(el_trigMatch_HLT_e24_lhmedium_L1EM20VH, std::vector<char>);
-  DECLARE_BRANCH(el_trigMatch_HLT_e24_lhmedium_nod0_L1EM18VH, std::vector<char>);
-  DECLARE_BRANCH(el_trigMatch_HLT_e60_lhmedium, std::vector<char>);
-  DECLARE_BRANCH(el_trigMatch_HLT_e26_lhtight_nod0_ivarloose, std::vector<char>);
-  DECLARE_BRANCH(el_trigMatch_HLT_e140_lhloose_nod0, std::vector<char>);
-  DECLARE_BRANCH(mu_trigMatch_HLT_mu26_ivarmedium, std::vector<char>);
-  DECLARE_BRANCH(mu_trigMatch_HLT_mu50, std::vector<char>);
-  DECLARE_BRANCH(mu_trigMatch_HLT_mu24, std::vector<char>);
-  DECLARE_BRANCH(mu_trigMatch_HLT_mu20_iloose_L1MU15, std::vector<char>);
+  DECLARE_VECTOR_BRANCH(el_trigMatch_HLT_e60_lhmedium_nod0, char);
+  DECLARE_VECTOR_BRANCH(el_trigMatch_HLT_e120_lhloose, char);
+  DECLARE_VECTOR_BRANCH(el_trigMatch_HLT_e24_lhmedium_L1EM20VH, char);
+  DECLARE_VECTOR_BRANCH(el_trigMatch_HLT_e24_lhmedium_nod0_L1EM18VH, char);
+  DECLARE_VECTOR_BRANCH(el_trigMatch_HLT_e60_lhmedium, char);
+  DECLARE_VECTOR_BRANCH(el_trigMatch_HLT_e26_lhtight_nod0_ivarloose, char);
+  DECLARE_VECTOR_BRANCH(el_trigMatch_HLT_e140_lhloose_nod0, char);
+  DECLARE_VECTOR_BRANCH(mu_trigMatch_HLT_mu26_ivarmedium, char);
+  DECLARE_VECTOR_BRANCH(mu_trigMatch_HLT_mu50, char);
+  DECLARE_VECTOR_BRANCH(mu_trigMatch_HLT_mu24, char);
+  DECLARE_VECTOR_BRANCH(mu_trigMatch_HLT_mu20_iloose_L1MU15, char);
   DECLARE_BRANCH_PRIMITIVE(lbn, UInt_t);
   DECLARE_BRANCH_PRIMITIVE(Vtxz, Float_t);
   DECLARE_BRANCH_PRIMITIVE(npVtx, UInt_t);
-  DECLARE_BRANCH(el_d0pv, std::vector<float>);
-  DECLARE_BRANCH(el_z0pv, std::vector<float>);
-  DECLARE_BRANCH(el_d0sigpv, std::vector<float>);
-  DECLARE_BRANCH(el_z0sigpv, std::vector<float>);
+  DECLARE_VECTOR_BRANCH(el_d0pv, float);
+  DECLARE_VECTOR_BRANCH(el_z0pv, float);
+  DECLARE_VECTOR_BRANCH(el_d0sigpv, float);
+  DECLARE_VECTOR_BRANCH(el_z0sigpv, float);
   DECLARE_BRANCH(el_tight_old, std::vector<bool>);
   DECLARE_BRANCH(el_trigMatch_old, std::vector<bool>);
-  DECLARE_BRANCH(el_tight, std::vector<char>);
-  DECLARE_BRANCH(el_trigMatch, std::vector<char>);
-  DECLARE_BRANCH(el_true_pdg, std::vector<int>);
-  DECLARE_BRANCH(el_true_pt, std::vector<float>);
-  DECLARE_BRANCH(el_true_eta, std::vector<float>);
-  DECLARE_BRANCH(el_truthIFFClass, std::vector<int>);
-  DECLARE_BRANCH(mu_d0pv, std::vector<float>);
-  DECLARE_BRANCH(mu_z0pv, std::vector<float>);
-  DECLARE_BRANCH(mu_d0sigpv, std::vector<float>);
-  DECLARE_BRANCH(mu_z0sigpv, std::vector<float>);
+  DECLARE_VECTOR_BRANCH(el_tight, char);
+  DECLARE_VECTOR_BRANCH(el_trigMatch, char);
+  DECLARE_VECTOR_BRANCH(el_true_pdg, int);
+  DECLARE_VECTOR_BRANCH(el_true_pt, float);
+  DECLARE_VECTOR_BRANCH(el_true_eta, float);
+  DECLARE_VECTOR_BRANCH(el_truthIFFClass, int);
+  DECLARE_VECTOR_BRANCH(mu_d0pv, float);
+  DECLARE_VECTOR_BRANCH(mu_z0pv, float);
+  DECLARE_VECTOR_BRANCH(mu_d0sigpv, float);
+  DECLARE_VECTOR_BRANCH(mu_z0sigpv, float);
   DECLARE_BRANCH(mu_tight_old, std::vector<bool>);
   DECLARE_BRANCH(mu_trigMatch_old, std::vector<bool>);
-  DECLARE_BRANCH(mu_tight, std::vector<char>);
-  DECLARE_BRANCH(mu_trigMatch, std::vector<char>);
-  DECLARE_BRANCH(mu_true_pdg, std::vector<int>);
-  DECLARE_BRANCH(mu_true_pt, std::vector<float>);
-  DECLARE_BRANCH(mu_true_eta, std::vector<float>);
-  DECLARE_BRANCH(mu_truthIFFClass, std::vector<int>);
-  DECLARE_BRANCH(jet_m, std::vector<float>);
-  DECLARE_BRANCH(jet_OLTau, std::vector<float>);
+  DECLARE_VECTOR_BRANCH(mu_tight, char);
+  DECLARE_VECTOR_BRANCH(mu_trigMatch, char);
+  DECLARE_VECTOR_BRANCH(mu_true_pdg, int);
+  DECLARE_VECTOR_BRANCH(mu_true_pt, float);
+  DECLARE_VECTOR_BRANCH(mu_true_eta, float);
+  DECLARE_VECTOR_BRANCH(mu_truthIFFClass, int);
+  DECLARE_VECTOR_BRANCH(jet_m, float);
+  DECLARE_VECTOR_BRANCH(jet_OLTau, float);
   DECLARE_BRANCH_PRIMITIVE(met_px, Float_t);
   DECLARE_BRANCH_PRIMITIVE(met_py, Float_t);
   DECLARE_BRANCH_PRIMITIVE(met_sumet, Float_t);
@@ -16,8 +16,13 @@
 #include <TopLoop/Core/Loggable.h>
 #include <TopLoop/Core/Utils.h>
 
+#include <TTreeReaderValue.h>
+
+#include <functional>
 #include <map>
 #include <memory>
+#include <set>
+#include <string>
 #include <tuple>
 #include <vector>
 
@@ -63,6 +68,27 @@ class WeightTool : public TL::Loggable {
   std::size_t m_idx_fsr_muR_20;
   std::size_t m_idx_fsr_muR_05;
 
+  struct WeightVariation {
+    std::string name;
+    std::string branch;
+    std::function<float()> nominal;
+    std::function<float()> scalar;
+    std::function<const std::vector<float>&()> vector;
+    std::size_t index;
+    std::size_t size;
+  };
+  std::vector<WeightVariation> m_weightVariations{};
+  std::vector<std::string> m_weightVariationNames{};
+  std::vector<float> m_weightVariationFactors{};
+  std::map<std::string, std::unique_ptr<TTreeReaderValue<float>>> m_wvScalarBranches{};
+  std::map<std::string, std::unique_ptr<TTreeReaderValue<std::vector<float>>>>
+      m_wvVectorBranches{};
+  mutable std::set<std::string> m_wvSizeWarnings{};
+
+  std::function<float()> weightVariationScalar(const std::string& branch);
+  std::function<const std::vector<float>&()> weightVariationVector(
+      const std::string& branch);
+
  public:
 
   /// @name Constructors
@@ -229,6 +255,89 @@ class WeightTool : public TL::Loggable {
 
   /// @}
 
+  /// @name weight-only systematic variations
+  /*!
+   *  Weight systematics (scale factor variations, pileup, JVT,
+   *  b-tagging eigenvectors, ...) do not change the event
+   *  selection. Instead of running a full loop per variation, the
+   *  variations are declared once in the algorithm's init() (after
+   *  TL::Algorithm::init()), and for each selected event all of them
+   *  are filled at once from the nominal weight:
+   *
+   *  @code{.cpp}
+   *  // init()
+   *  weightTool().addWeightVariation("weight_pileup_UP", "weight_pileup");
+   *  weightTool().addWeightVariation("weight_pileup_DOWN", "weight_pileup");
+   *  weightTool().addWeightVariationVector("weight_bTagSF_DL1r_77_eigenvars_B_up",
+   *                                        "weight_bTagSF_DL1r_77");
+   *  for (const auto& name : weightTool().weightVariationNames()) {
+   *    // book one histogram per variation
+   *  }
+   *  @endcode
+   *  @code{.cpp}
+   *  // execute(), after the selection
+   *  auto fill = [&](std::size_t i, float w) { m_hists[i]->Fill(x, w); };
+   *  TL_CHECK(weightTool().fillWeightVariations(nominalWeight, fill));
+   *  @endcode
+   *
+   *  A varied weight is the nominal weight with the nominal component
+   *  replaced by the variation: nominal weight * variation /
+   *  component. If the nominal component of an event is zero, the
+   *  varied weights of that component are zero for the event.
+   *
+   *  The branches are read through the algorithm's accessors (e.g.
+   *  TL::Variables::weight_pileup) when TopLoop knows them, so they
+   *  are not read a second time; other branches get their own
+   *  TTreeReaderValue on the algorithm's reader.
+   */
+  /// @{
+
+  /// declare a variation stored in a float branch (e.g. weight_pileup_UP)
+  /*!
+   *  @param branch the name of the branch holding the varied component
+   *  @param nominal the name of the nominal component it replaces (e.g. weight_pileup)
+   */
+  TL::StatusCode addWeightVariation(const std::string& branch, const std::string& nominal);
+
+  /// declare the variations stored in a vector<float> branch (e.g. b-tagging eigenvars)
+  /*!
+   *  Each element of the vector is a variation, named
+   *  "<branch>_<index>". The size of the vector is taken from the
+   *  first entry of the main tree where it is not empty (read from a
+   *  copy of the chain, the algorithm's reader is not moved). In an
+   *  event where the vector is shorter, the missing variations are
+   *  zero; extra elements are ignored. Either is logged once per
+   *  branch.
+   *
+   *  @param branch the name of the branch holding the varied components
+   *  @param nominal the name of the nominal component they replace
+   */
+  TL::StatusCode addWeightVariationVector(const std::string& branch,
+                                          const std::string& nominal);
+
+  /// the names of the declared variations (in the order they are filled)
+  const std::vector<std::string>& weightVariationNames() const {
+    return m_weightVariationNames;
+  }
+
+  /// the number of declared variations
+  std::size_t nWeightVariations() const { return m_weightVariations.size(); }
+
+  /// the ratios (variation / nominal component) for the current event
+  TL::StatusCode weightVariationFactors(std::vector<float>& factors) const;
+
+  /// call fill(i, varied weight) for each declared variation i of the current event
+  template <typename F>
+  TL::StatusCode fillWeightVariations(const float nominalWeight, F&& fill) {
+    TL_CHECK(weightVariationFactors(m_weightVariationFactors));
+    for (std::size_t i = 0; i < m_weightVariationFactors.size(); ++i) {
+      fill(i, nominalWeight * m_weightVariationFactors[i]);
+    }
+    return TL::StatusCode::SUCCESS;
+  }
+
+  /// @}
+
   /// @name cross section helpers
   /// @{
 